@@ -0,0 +1,173 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// GFLOP/s of the blocked choldc1() behind invert() against the previous
+// textbook triple loop, for SPD matrices of increasing size, and of the
+// float factor mixed_cholesky uses. Cholesky costs n^3 / 3 flops.
+
+#if !defined(NDEBUG)
+# define NDEBUG
+#endif
+#define BOOST_UBLAS_MOVE_SEMANTICS
+#define BOOST_UBLAS_NDEBUG
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+#include "fmt/format.h"
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_util.hpp"
+
+namespace {
+
+using value_type = double;
+using matrix = yafiyogi::yy_maths::matrix<value_type>;
+using vector = yafiyogi::yy_maths::vector<value_type>;
+using size_type = matrix::size_type;
+using clock_type = std::chrono::steady_clock;
+
+// Textbook factorisation, as choldc1() was before blocking.
+bool reference_choldc1(matrix & a,
+                       vector & p) noexcept
+{
+  const size_type size = a.size1();
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    for(size_type j = i; j < size; ++j)
+    {
+      value_type sum = a(i, j);
+
+      for(int k = static_cast<int>(i) - 1; k >= 0; --k)
+      {
+        sum -= a(i, static_cast<size_type>(k)) * a(j, static_cast<size_type>(k));
+      }
+
+      if(i == j)
+      {
+        if(sum <= value_type{})
+        {
+          return false;
+        }
+        p(i) = std::sqrt(sum);
+      }
+      else
+      {
+        a(j, i) = sum / p(i);
+      }
+    }
+  }
+
+  return true;
+}
+
+// Diagonally dominant, so symmetric positive definite.
+matrix make_spd(size_type p_size)
+{
+  matrix A{p_size, p_size};
+
+  for(size_type i = 0; i < p_size; ++i)
+  {
+    for(size_type j = 0; j < p_size; ++j)
+    {
+      A(i, j) = std::sin(static_cast<value_type>(i * 7 + j * 13)) / static_cast<value_type>(p_size);
+    }
+  }
+
+  for(size_type i = 0; i < p_size; ++i)
+  {
+    for(size_type j = 0; j < i; ++j)
+    {
+      A(i, j) = A(j, i);
+    }
+    A(i, i) += value_type{2};
+  }
+
+  return A;
+}
+
+template<typename T,
+         typename Factor>
+double gflops(const matrix & A,
+              Factor && factor)
+{
+  const size_type size = A.size1();
+  const yafiyogi::yy_maths::matrix<T> A_t{A};
+  yafiyogi::yy_maths::matrix<T> a{size, size};
+  yafiyogi::yy_maths::vector<T> p{size};
+
+  // Aim for ~2e8 flops per measurement.
+  const double flops = static_cast<double>(size * size * size) / 3.0;
+  const size_type reps = std::max(size_type{1}, static_cast<size_type>(2e8 / flops));
+
+  double best = 0.0;
+  for(int trial = 0; trial < 3; ++trial)
+  {
+    double elapsed = 0.0;
+    for(size_type r = 0; r < reps; ++r)
+    {
+      boost::numeric::ublas::noalias(a) = A_t;
+
+      const auto start = clock_type::now();
+      factor(a, p);
+      elapsed += std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    best = std::max(best, flops * static_cast<double>(reps) / elapsed * 1e-9);
+  }
+
+  return best;
+}
+
+} // anonymous namespace
+
+int main()
+{
+  fmt::print("{:>6} {:>12} {:>12} {:>8} {:>12} {:>8}\n", "n", "reference", "blocked", "speedup", "float", "speedup");
+
+  for(size_type size : {8, 16, 32, 64, 128, 256, 512, 1024})
+  {
+    const matrix A = make_spd(size);
+
+    const double reference = gflops<value_type>(A, [](matrix & a, vector & p) {
+      return reference_choldc1(a, p);
+    });
+    const double blocked = gflops<value_type>(A, [](matrix & a, vector & p) {
+      return yafiyogi::yy_maths::matrix_util_detail::choldc1(a, p);
+    });
+    const double single = gflops<float>(A, [](auto & a, auto & p) {
+      return yafiyogi::yy_maths::matrix_util_detail::choldc1(a, p);
+    });
+
+    fmt::print("{:>6} {:>12.3f} {:>12.3f} {:>7.2f}x {:>12.3f} {:>7.2f}x\n",
+               size, reference, blocked, blocked / reference, single, single / blocked);
+  }
+
+  return 0;
+}
@@ -44,14 +44,15 @@ constexpr size_type ekf_m = 3;
 
 void predict_update(ekf & filter,
                     const matrix & h,
-                    const vector & z)
+                    const vector & z,
+                    ekf::measurement_mask valid = ~ekf::measurement_mask{})
 {
   filter.predict();
 
   vector hx{ekf_m};
   hx <<= filter.X(0), filter.X(1), filter.X(1);
 
-  filter.update(z, h, hx);
+  filter.update(z, h, hx, valid);
 }
 
 int main()
@@ -61,15 +62,9 @@ int main()
         0, 1,
         0, 1;
 
-  matrix H1{ekf_m, ekf_n};
-  H1 <<= 1, 0,
-         0, 1,
-         0, 0;
-
-  matrix H2{ekf_m, ekf_n};
-  H2 <<= 1, 0,
-         0, 0,
-         0, 1;
+  // Missing measurements are masked out rather than zeroed in H.
+  constexpr ekf::measurement_mask valid1 = 0b011;
+  constexpr ekf::measurement_mask valid2 = 0b101;
 
   vector z{ekf_m};
 
@@ -91,27 +86,27 @@ int main()
     ekf ekf_state{ekf_m, ekf_n};
 
     z <<= 49.49, 22, 23;
-    predict_update(ekf_state, H1, z);
+    predict_update(ekf_state, H, z, valid1);
     fmt::print("1a) h=[{}] t=[{}]\n", ekf_state.X(0), ekf_state.X(1));
 
     z <<= 49.49, 22, 0.0;
-    predict_update(ekf_state, H1, z);
+    predict_update(ekf_state, H, z, valid1);
     fmt::print("1a) h=[{}] t=[{}]\n", ekf_state.X(0), ekf_state.X(1));
 
     z <<= 49.49, 22, 23;
-    predict_update(ekf_state, H1, z);
+    predict_update(ekf_state, H, z, valid1);
     fmt::print("1a) h=[{}] t=[{}]\n", ekf_state.X(0), ekf_state.X(1));
 
     z <<= 49.49, 22, 23;
-    predict_update(ekf_state, H2, z);
+    predict_update(ekf_state, H, z, valid2);
     fmt::print("1b) h=[{}] t=[{}]\n", ekf_state.X(0), ekf_state.X(1));
 
     z <<= 49.59, 21, 24;
-    predict_update(ekf_state, H1, z);
+    predict_update(ekf_state, H, z, valid1);
     fmt::print("2a) h=[{}] t=[{}]\n", ekf_state.X(0), ekf_state.X(1));
 
     z <<= 49.59, 0.0, 24;
-    predict_update(ekf_state, H2, z);
+    predict_update(ekf_state, H, z, valid2);
     fmt::print("2b) h=[{}] t=[{}]\n", ekf_state.X(0), ekf_state.X(1));
   }
 
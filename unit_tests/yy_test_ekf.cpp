@@ -0,0 +1,396 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "yy_ekf.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestEkf:
+      public testing::Test
+{
+  public:
+    using value_type = ekf::value_type;
+    using size_type = ekf::size_type;
+    using matrix = ekf::matrix;
+    using vector = ekf::vector;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    // Row i of H observes state i % n, plus half of state (i + 1) % n.
+    static matrix observation(size_type p_m,
+                              size_type p_n)
+    {
+      matrix h{p_m, p_n, value_type{}};
+      for(size_type i = 0; i < p_m; ++i)
+      {
+        h(i, i % p_n) += value_type{1};
+        h(i, (i + 1) % p_n) += value_type{0.5};
+      }
+
+      return h;
+    }
+
+    static vector predicted(const ekf & p_filter,
+                            const matrix & p_h)
+    {
+      vector hx{p_h.size1(), value_type{}};
+      for(size_type i = 0; i < p_h.size1(); ++i)
+      {
+        for(size_type j = 0; j < p_h.size2(); ++j)
+        {
+          hx(i) += p_h(i, j) * p_filter.X(j);
+        }
+      }
+
+      return hx;
+    }
+
+    static vector measurement(size_type p_m,
+                              value_type p_value)
+    {
+      return vector{p_m, p_value};
+    }
+};
+
+TEST_F(TestEkf, SharedWorkspaceDifferentSizes)
+{
+  const matrix h_32 = observation(3, 2);
+  const matrix h_22 = observation(2, 2);
+
+  ekf shared_32{3, 2};
+  ekf shared_22{2, 2};
+  ekf own_32{3, 2};
+  ekf own_22{2, 2};
+
+  // Sized for the smaller filter, then handed to both.
+  ekf::workspace workspace{2, 2};
+
+  for(size_type step = 0; step < 20; ++step)
+  {
+    const value_type z = value_type{1} + static_cast<value_type>(step) * value_type{0.1};
+
+    shared_32.predict(workspace);
+    EXPECT_TRUE(shared_32.update(measurement(3, z), h_32, predicted(shared_32, h_32), workspace));
+    shared_22.predict(workspace);
+    EXPECT_TRUE(shared_22.update(measurement(2, z), h_22, predicted(shared_22, h_22), workspace));
+    shared_32.update_sequential(measurement(3, z), h_32, predicted(shared_32, h_32), workspace);
+    EXPECT_TRUE(shared_22.update(measurement(2, z), h_22, predicted(shared_22, h_22), ekf::measurement_mask{1}, workspace));
+
+    own_32.predict();
+    EXPECT_TRUE(own_32.update(measurement(3, z), h_32, predicted(own_32, h_32)));
+    own_22.predict();
+    EXPECT_TRUE(own_22.update(measurement(2, z), h_22, predicted(own_22, h_22)));
+    own_32.update_sequential(measurement(3, z), h_32, predicted(own_32, h_32));
+    EXPECT_TRUE(own_22.update(measurement(2, z), h_22, predicted(own_22, h_22), ekf::measurement_mask{1}));
+  }
+
+  for(size_type i = 0; i < 2; ++i)
+  {
+    EXPECT_EQ(shared_32.X(i), own_32.X(i));
+    EXPECT_EQ(shared_22.X(i), own_22.X(i));
+  }
+}
+
+TEST_F(TestEkf, LazyPredictMatchesEager)
+{
+  constexpr size_type n = 4;
+  const matrix h = observation(3, n);
+
+  matrix F{ekf::identity_matrix{n}};
+  for(size_type i = 0; i < n; ++i)
+  {
+    F(i, (i + 1) % n) = value_type{0.1};
+  }
+
+  const ekf::process_model models[] = {
+    ekf::identity_model{value_type{0.01}},
+    ekf::constant_velocity_model{value_type{0.5}, value_type{0.01}},
+    ekf::dense_model{F, value_type{0.01}}
+  };
+
+  for(const auto & model : models)
+  {
+    ekf lazy{3, n, vector{3, value_type{0.1}}, model};
+    ekf eager{3, n, vector{3, value_type{0.1}}, model};
+
+    for(size_type step = 0; step < 12; ++step)
+    {
+      const size_type predicts = 1 + (step % 4);
+      for(size_type k = 0; k < predicts; ++k)
+      {
+        lazy.predict();
+
+        // Resetting the model applies the pending predict.
+        eager.predict();
+        eager.model(model);
+      }
+      EXPECT_EQ(predicts, lazy.pending_predicts());
+      EXPECT_EQ(0U, eager.pending_predicts());
+
+      const vector z = measurement(3, std::cos(static_cast<value_type>(step)));
+      EXPECT_TRUE(lazy.update(z, h, predicted(lazy, h)));
+      EXPECT_TRUE(eager.update(z, h, predicted(eager, h)));
+    }
+
+    for(size_type i = 0; i < n; ++i)
+    {
+      EXPECT_NEAR(eager.X(i), lazy.X(i), 1e-12);
+      for(size_type j = 0; j < n; ++j)
+      {
+        EXPECT_NEAR(eager.P()(i, j), lazy.P()(i, j), 1e-12);
+      }
+    }
+  }
+}
+
+TEST_F(TestEkf, SequentialMatchesDense)
+{
+  const matrix h = observation(3, 2);
+  vector r{3};
+  r(0) = value_type{0.5};
+  r(1) = value_type{0.1};
+  r(2) = value_type{0.02};
+
+  ekf dense{3, 2, r};
+  ekf sequential{3, 2, r};
+
+  for(size_type step = 0; step < 20; ++step)
+  {
+    vector z{3};
+    for(size_type i = 0; i < 3; ++i)
+    {
+      z(i) = std::sin(value_type{0.3} * static_cast<value_type>(step + i));
+    }
+
+    dense.predict();
+    EXPECT_TRUE(dense.update(z, h, predicted(dense, h)));
+    sequential.predict();
+    sequential.update_sequential(z, h, predicted(sequential, h));
+  }
+
+  for(size_type i = 0; i < 2; ++i)
+  {
+    EXPECT_NEAR(dense.X(i), sequential.X(i), 1e-12);
+    for(size_type j = 0; j < 2; ++j)
+    {
+      EXPECT_NEAR(dense.P()(i, j), sequential.P()(i, j), 1e-12);
+    }
+  }
+}
+
+TEST_F(TestEkf, SequentialNotPositiveDefinite)
+{
+  const matrix h = observation(2, 2);
+  vector r{2};
+  r(0) = ekf::EPS;
+  r(1) = value_type{-10}; // H P H^T + R isn't positive definite.
+
+  ekf dense{2, 2, r};
+  ekf sequential{2, 2, r};
+  ekf masked{2, 2, r};
+  const vector z = measurement(2, value_type{1});
+
+  dense.predict();
+  EXPECT_FALSE(dense.update(z, h, predicted(dense, h)));
+
+  // The uninformative second measurement is skipped, leaving the first.
+  sequential.predict();
+  sequential.update_sequential(z, h, predicted(sequential, h));
+  masked.predict();
+  EXPECT_TRUE(masked.update(z, h, predicted(masked, h), ekf::measurement_mask{0b01}));
+
+  for(size_type i = 0; i < 2; ++i)
+  {
+    EXPECT_TRUE(std::isfinite(sequential.X(i)));
+    EXPECT_NEAR(masked.X(i), sequential.X(i), 1e-12);
+    for(size_type j = 0; j < 2; ++j)
+    {
+      EXPECT_NEAR(masked.P()(i, j), sequential.P()(i, j), 1e-12);
+    }
+  }
+}
+
+TEST_F(TestEkf, SparseMatchesDense)
+{
+  const matrix h = observation(3, 4);
+  const ekf::observation h_sparse{h};
+
+  ekf dense{3, 4};
+  ekf sparse{3, 4};
+
+  for(size_type step = 0; step < 20; ++step)
+  {
+    const vector z = measurement(3, std::sin(static_cast<value_type>(step)));
+
+    dense.predict();
+    EXPECT_TRUE(dense.update(z, h, predicted(dense, h)));
+    sparse.predict();
+    EXPECT_TRUE(sparse.update(z, h_sparse, predicted(sparse, h)));
+  }
+
+  for(size_type i = 0; i < 4; ++i)
+  {
+    EXPECT_NEAR(dense.X(i), sparse.X(i), 1e-12);
+    for(size_type j = 0; j < 4; ++j)
+    {
+      EXPECT_NEAR(dense.P()(i, j), sparse.P()(i, j), 1e-12);
+    }
+  }
+}
+
+TEST_F(TestEkf, MaskedMatchesSubBlock)
+{
+  const matrix h = observation(3, 2);
+  vector r{3};
+  r(0) = value_type{0.5};
+  r(1) = value_type{0.1};
+  r(2) = value_type{0.02};
+  constexpr ekf::measurement_mask mask{0b101};
+
+  // Rows 0 & 2 only.
+  matrix h_sub{2, 2};
+  vector r_sub{2};
+  for(size_type j = 0; j < 2; ++j)
+  {
+    h_sub(0, j) = h(0, j);
+    h_sub(1, j) = h(2, j);
+  }
+  r_sub(0) = r(0);
+  r_sub(1) = r(2);
+
+  ekf masked{3, 2, r};
+  ekf dense{2, 2, r_sub};
+
+  for(size_type step = 0; step < 20; ++step)
+  {
+    vector z{3};
+    for(size_type i = 0; i < 3; ++i)
+    {
+      z(i) = std::sin(value_type{0.3} * static_cast<value_type>(step + i));
+    }
+    vector z_sub{2};
+    z_sub(0) = z(0);
+    z_sub(1) = z(2);
+
+    masked.predict();
+    EXPECT_TRUE(masked.update(z, h, predicted(masked, h), mask));
+    dense.predict();
+    EXPECT_TRUE(dense.update(z_sub, h_sub, predicted(dense, h_sub)));
+  }
+
+  for(size_type i = 0; i < 2; ++i)
+  {
+    EXPECT_NEAR(dense.X(i), masked.X(i), 1e-12);
+    for(size_type j = 0; j < 2; ++j)
+    {
+      EXPECT_NEAR(dense.P()(i, j), masked.P()(i, j), 1e-12);
+    }
+  }
+}
+
+TEST_F(TestEkf, GateSteadyState)
+{
+  const matrix h = observation(2, 2);
+
+  ekf filter{2, 2};
+  filter.steady_state(value_type{1e-9});
+
+  for(size_type step = 0; (step < 1000) && !filter.steady(); ++step)
+  {
+    filter.predict();
+    EXPECT_TRUE(filter.update(measurement(2, value_type{10}), h, predicted(filter, h)));
+  }
+  ASSERT_TRUE(filter.steady());
+
+  filter.gate(value_type{13.8}); // 99.9% with 2 measurements.
+  filter.predict();
+  const vector x{filter.X()};
+  EXPECT_FALSE(filter.update(measurement(2, value_type{1e6}), h, predicted(filter, h)));
+  EXPECT_EQ(1U, filter.rejected_updates());
+  EXPECT_EQ(x(0), filter.X(0));
+  EXPECT_EQ(x(1), filter.X(1));
+  EXPECT_TRUE(filter.steady());
+
+  EXPECT_TRUE(filter.update(measurement(2, value_type{10}), h, predicted(filter, h)));
+  EXPECT_EQ(1U, filter.rejected_updates());
+  EXPECT_TRUE(filter.steady());
+}
+
+TEST_F(TestEkf, GateCachedGain)
+{
+  const matrix h = observation(3, 2);
+  constexpr ekf::measurement_mask mask{0b011};
+
+  ekf filter{3, 2};
+  filter.cache_gains(2, value_type{1e-9});
+
+  for(size_type step = 0; (step < 1000) && (0 == filter.cache_hits()); ++step)
+  {
+    filter.predict();
+    EXPECT_TRUE(filter.update(measurement(3, value_type{10}), h, predicted(filter, h)));
+    filter.predict();
+    EXPECT_TRUE(filter.update(measurement(3, value_type{10}), h, predicted(filter, h), mask));
+  }
+  ASSERT_LT(0U, filter.cache_hits());
+
+  filter.gate(value_type{16.3}); // 99.9% with 3 measurements.
+
+  // Dense pattern.
+  filter.predict();
+  vector x{filter.X()};
+  EXPECT_FALSE(filter.update(measurement(3, value_type{1e6}), h, predicted(filter, h)));
+  EXPECT_EQ(1U, filter.rejected_updates());
+  EXPECT_EQ(x(0), filter.X(0));
+  EXPECT_EQ(x(1), filter.X(1));
+
+  // Masked pattern.
+  const size_type hits = filter.cache_hits();
+  EXPECT_TRUE(filter.update(measurement(3, value_type{10}), h, predicted(filter, h)));
+  filter.predict();
+  EXPECT_TRUE(filter.update(measurement(3, value_type{10}), h, predicted(filter, h), mask));
+  EXPECT_LT(hits, filter.cache_hits());
+
+  filter.predict();
+  EXPECT_TRUE(filter.update(measurement(3, value_type{10}), h, predicted(filter, h)));
+  filter.predict();
+  x = filter.X();
+  EXPECT_FALSE(filter.update(measurement(3, value_type{1e6}), h, predicted(filter, h), mask));
+  EXPECT_EQ(2U, filter.rejected_updates());
+  EXPECT_EQ(x(0), filter.X(0));
+  EXPECT_EQ(x(1), filter.X(1));
+}
+
+} // namespace yafiyogi::yy_maths::tests
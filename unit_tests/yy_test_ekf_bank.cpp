@@ -0,0 +1,128 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "yy_ekf.hpp"
+#include "yy_ekf_bank.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestEkfBank:
+      public testing::Test
+{
+  public:
+    static constexpr std::size_t m = 3;
+    static constexpr std::size_t n = 2;
+    using bank_type = ekf_bank<m, n>;
+    using size_type = bank_type::size_type;
+    using matrix = bank_type::matrix;
+    using matrix_mn = bank_type::matrix_mn;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(TestEkfBank, MatchesSeparateFilters)
+{
+  // More than one block of filters, the last one partial.
+  constexpr size_type count = 70;
+
+  matrix_mn h;
+  ekf::matrix h_dense{m, n};
+  for(size_type i = 0; i < m; ++i)
+  {
+    for(size_type j = 0; j < n; ++j)
+    {
+      h(i, j) = (i % n == j) ? 1.0 : 0.25 * static_cast<double>(i + 1);
+      h_dense(i, j) = h(i, j);
+    }
+  }
+
+  bank_type bank{count};
+  std::vector<ekf> filters(count, ekf{m, n});
+
+  matrix z{m, count};
+  matrix hx{m, count};
+  for(size_type step = 0; step < 25; ++step)
+  {
+    for(size_type f = 0; f < count; ++f)
+    {
+      for(size_type i = 0; i < m; ++i)
+      {
+        z(i, f) = std::sin(0.1 * static_cast<double>(step + f) + static_cast<double>(i));
+        hx(i, f) = 0.0;
+        for(size_type j = 0; j < n; ++j)
+        {
+          hx(i, f) += h(i, j) * bank.X(f, j);
+        }
+      }
+    }
+
+    bank.predict();
+    EXPECT_EQ(count, bank.update(z, h, hx));
+
+    for(size_type f = 0; f < count; ++f)
+    {
+      ekf::vector z_f{m};
+      ekf::vector hx_f{m};
+      for(size_type i = 0; i < m; ++i)
+      {
+        z_f(i) = z(i, f);
+        hx_f(i) = 0.0;
+        for(size_type j = 0; j < n; ++j)
+        {
+          hx_f(i) += h(i, j) * filters[f].X(j);
+        }
+      }
+
+      filters[f].predict();
+      EXPECT_TRUE(filters[f].update(z_f, h_dense, hx_f));
+    }
+  }
+
+  for(size_type f = 0; f < count; ++f)
+  {
+    for(size_type i = 0; i < n; ++i)
+    {
+      EXPECT_NEAR(filters[f].X(i), bank.X(f, i), 1e-12);
+      for(size_type j = 0; j < n; ++j)
+      {
+        EXPECT_NEAR(filters[f].P()(i, j), bank.P(f, i, j), 1e-12);
+      }
+    }
+  }
+}
+
+} // namespace yafiyogi::yy_maths::tests
@@ -0,0 +1,124 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "yy_ekf.hpp"
+#include "yy_ekf_group.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestEkfGroup:
+      public testing::Test
+{
+  public:
+    using value_type = ekf_group::value_type;
+    using size_type = ekf_group::size_type;
+    using matrix = ekf_group::matrix;
+    using vector = ekf_group::vector;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(TestEkfGroup, MatchesSeparateFilters)
+{
+  constexpr size_type m = 3;
+  constexpr size_type n = 4;
+  constexpr size_type members = 5;
+
+  matrix h{m, n};
+  for(size_type i = 0; i < m; ++i)
+  {
+    for(size_type j = 0; j < n; ++j)
+    {
+      h(i, j) = std::cos(static_cast<value_type>(i * n + j));
+    }
+  }
+
+  const vector r{m, value_type{0.1}};
+  const ekf_group::process_model model{ekf_group::constant_velocity_model{value_type{0.5}, value_type{0.01}}};
+
+  ekf_group group{m, n, members, r, model};
+  std::vector<ekf> filters(members, ekf{m, n, r, model});
+
+  matrix z{m, members};
+  matrix hx{m, members};
+  for(size_type step = 0; step < 20; ++step)
+  {
+    const size_type predicts = 1 + (step % 3);
+    group.predict(predicts);
+
+    for(size_type f = 0; f < members; ++f)
+    {
+      vector z_f{m};
+      vector hx_f{m, value_type{}};
+      for(size_type i = 0; i < m; ++i)
+      {
+        z(i, f) = z_f(i) = std::sin(value_type{0.2} * static_cast<value_type>(step + i * members + f));
+        hx(i, f) = 0.0;
+        for(size_type j = 0; j < n; ++j)
+        {
+          hx(i, f) += h(i, j) * group.X(f, j);
+        }
+      }
+
+      filters[f].predict(predicts);
+      for(size_type i = 0; i < m; ++i)
+      {
+        for(size_type j = 0; j < n; ++j)
+        {
+          hx_f(i) += h(i, j) * filters[f].X(j);
+        }
+      }
+      EXPECT_TRUE(filters[f].update(z_f, h, hx_f));
+    }
+
+    EXPECT_TRUE(group.update(z, h, hx));
+  }
+
+  for(size_type f = 0; f < members; ++f)
+  {
+    for(size_type i = 0; i < n; ++i)
+    {
+      EXPECT_NEAR(filters[f].X(i), group.X(f, i), 1e-12);
+      for(size_type j = 0; j < n; ++j)
+      {
+        EXPECT_NEAR(filters[f].P()(i, j), group.P()(i, j), 1e-12);
+      }
+    }
+  }
+}
+
+} // namespace yafiyogi::yy_maths::tests
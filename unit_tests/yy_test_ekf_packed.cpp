@@ -0,0 +1,109 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "yy_ekf.hpp"
+#include "yy_ekf_packed.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestEkfPacked:
+      public testing::Test
+{
+  public:
+    using value_type = ekf_packed::value_type;
+    using size_type = ekf_packed::size_type;
+    using matrix = ekf_packed::matrix;
+    using vector = ekf_packed::vector;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(TestEkfPacked, MatchesEkf)
+{
+  constexpr size_type m = 3;
+  constexpr size_type n = 5;
+
+  matrix h{m, n, value_type{}};
+  for(size_type i = 0; i < m; ++i)
+  {
+    for(size_type j = 0; j < n; ++j)
+    {
+      h(i, j) = std::cos(static_cast<value_type>(i * n + j));
+    }
+  }
+
+  vector r{m};
+  for(size_type i = 0; i < m; ++i)
+  {
+    r(i) = value_type{0.1} * static_cast<value_type>(i + 1);
+  }
+
+  ekf_packed packed{m, n, r};
+  ekf dense{m, n, r};
+
+  for(size_type step = 0; step < 15; ++step)
+  {
+    vector z{m};
+    vector hx_packed{m, value_type{}};
+    vector hx_dense{m, value_type{}};
+    for(size_type i = 0; i < m; ++i)
+    {
+      z(i) = std::sin(value_type{0.2} * static_cast<value_type>(step + i));
+      for(size_type j = 0; j < n; ++j)
+      {
+        hx_packed(i) += h(i, j) * packed.X(j);
+        hx_dense(i) += h(i, j) * dense.X(j);
+      }
+    }
+
+    const size_type predicts = 1 + (step % 3);
+    packed.predict(predicts);
+    dense.predict(predicts);
+    EXPECT_TRUE(packed.update(z, h, hx_packed));
+    EXPECT_TRUE(dense.update(z, h, hx_dense));
+  }
+
+  for(size_type i = 0; i < n; ++i)
+  {
+    EXPECT_NEAR(dense.X(i), packed.X(i), 1e-12);
+    for(size_type j = 0; j < n; ++j)
+    {
+      EXPECT_NEAR(dense.P()(i, j), packed.P()(i, j), 1e-12);
+    }
+  }
+}
+
+} // namespace yafiyogi::yy_maths::tests
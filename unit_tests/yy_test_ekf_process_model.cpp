@@ -0,0 +1,143 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "gtest/gtest.h"
+
+#include "yy_ekf_process_model.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestEkfProcessModel:
+      public testing::Test
+{
+  public:
+    using value_type = double;
+    using dense_model = dense_process_model<value_type>;
+    using matrix = dense_model::matrix;
+    using vector = dense_model::vector;
+    using size_type = dense_model::size_type;
+
+    static constexpr size_type n = 5; // Odd, so a trailing constant state.
+    static constexpr size_type steps = 7;
+    static constexpr value_type q = 0.01;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    // Diagonally dominant, so symmetric positive definite.
+    static matrix covariance()
+    {
+      matrix P{n, n};
+      for(size_type i = 0; i < n; ++i)
+      {
+        for(size_type j = 0; j < n; ++j)
+        {
+          P(i, j) = (i == j) ? value_type{2} : value_type{0.1} * static_cast<value_type>(i + j + 1) / static_cast<value_type>(n);
+        }
+      }
+
+      return P;
+    }
+
+    static vector state()
+    {
+      vector x{n};
+      for(size_type i = 0; i < n; ++i)
+      {
+        x(i) = static_cast<value_type>(i + 1) * value_type{0.5} - value_type{1};
+      }
+
+      return x;
+    }
+
+    template<typename Model>
+    static void expect_model(const Model & p_model,
+                             const matrix & p_F)
+    {
+      const dense_model dense{p_F, q};
+      matrix scratch{n, n};
+      vector scratch_x{n};
+
+      const vector x0{state()};
+      vector x{x0};
+      vector x_dense{x0};
+      p_model.predict_state(x, steps, scratch_x);
+      dense.predict_state(x_dense, steps, scratch_x);
+
+      matrix X{n, 2};
+      matrix X_dense{n, 2};
+      for(size_type i = 0; i < n; ++i)
+      {
+        X(i, 0) = X_dense(i, 0) = x0(i);
+        X(i, 1) = X_dense(i, 1) = -x0(i);
+      }
+      matrix scratch_X{n, 2};
+      p_model.predict_states(X, steps, scratch_X);
+      dense.predict_states(X_dense, steps, scratch_X);
+
+      matrix P{covariance()};
+      matrix P_dense{covariance()};
+      p_model.predict_covariance(P, steps, scratch);
+      dense.predict_covariance(P_dense, steps, scratch);
+
+      for(size_type i = 0; i < n; ++i)
+      {
+        EXPECT_NEAR(x_dense(i), x(i), 1e-12);
+        EXPECT_NEAR(X_dense(i, 0), X(i, 0), 1e-12);
+        EXPECT_NEAR(X_dense(i, 1), X(i, 1), 1e-12);
+        for(size_type j = 0; j < n; ++j)
+        {
+          EXPECT_NEAR(P_dense(i, j), P(i, j), 1e-12);
+        }
+      }
+    }
+};
+
+TEST_F(TestEkfProcessModel, IdentityMatchesDense)
+{
+  expect_model(identity_process_model<value_type>{q},
+               identity_matrix<value_type>{n});
+}
+
+TEST_F(TestEkfProcessModel, ConstantVelocityMatchesDense)
+{
+  constexpr value_type dt = 0.25;
+
+  matrix F{identity_matrix<value_type>{n}};
+  for(size_type i = 0; i + 1 < n; i += 2)
+  {
+    F(i, i + 1) = dt;
+  }
+
+  expect_model(constant_velocity_process_model<value_type>{dt, q}, F);
+}
+
+} // namespace yafiyogi::yy_maths::tests
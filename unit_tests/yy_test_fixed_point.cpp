@@ -0,0 +1,111 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "gtest/gtest.h"
+
+#include "yy_fixed_point.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+template<typename Q>
+class TestFixedPoint:
+      public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+using fixed_point_types = testing::Types<q16_16, q32_32>;
+TYPED_TEST_SUITE(TestFixedPoint, fixed_point_types);
+
+TYPED_TEST(TestFixedPoint, DivideExact)
+{
+  using Q = TypeParam;
+
+  EXPECT_EQ(Q{-7}, Q{7} / Q{-1});
+  EXPECT_EQ(Q{7}, Q{-7} / Q{-1});
+  EXPECT_EQ(Q{-7}, Q{-7} / Q{1});
+  EXPECT_EQ(Q{-1.5}, Q{3} / Q{-2});
+  EXPECT_EQ(Q{-1.5}, Q{-3} / Q{2});
+  EXPECT_EQ(Q{1.5}, Q{-3} / Q{-2});
+  EXPECT_EQ(Q{-0.25}, Q{1} / Q{-4});
+  EXPECT_EQ(Q{-2}, Q{-0.5} / Q{0.25});
+}
+
+TYPED_TEST(TestFixedPoint, DivideRounding)
+{
+  using Q = TypeParam;
+  using rep_type = typename Q::rep_type;
+
+  // 1/3 & 2/3 round to the nearest raw value, symmetric in sign.
+  const rep_type third = (Q::one_raw + 1) / 3;
+  const rep_type two_thirds = (2 * Q::one_raw + 1) / 3;
+
+  EXPECT_EQ(third, (Q{1} / Q{3}).raw());
+  EXPECT_EQ(-third, (Q{1} / Q{-3}).raw());
+  EXPECT_EQ(-third, (Q{-1} / Q{3}).raw());
+  EXPECT_EQ(third, (Q{-1} / Q{-3}).raw());
+  EXPECT_EQ(two_thirds, (Q{2} / Q{3}).raw());
+  EXPECT_EQ(-two_thirds, (Q{2} / Q{-3}).raw());
+  EXPECT_EQ(-two_thirds, (Q{-2} / Q{3}).raw());
+
+  // Halves round away from zero.
+  EXPECT_EQ(rep_type{1}, (Q::epsilon() / Q{2}).raw());
+  EXPECT_EQ(rep_type{-1}, (Q::epsilon() / Q{-2}).raw());
+  EXPECT_EQ(rep_type{-1}, (-Q::epsilon() / Q{2}).raw());
+}
+
+TYPED_TEST(TestFixedPoint, DivideSaturates)
+{
+  using Q = TypeParam;
+
+  EXPECT_EQ(Q::max(), Q{1} / Q{});
+  EXPECT_EQ(Q::min(), Q{-1} / Q{});
+  EXPECT_EQ(Q{}, Q{} / Q{});
+  EXPECT_EQ(Q::max(), Q::max() / Q::epsilon());
+  EXPECT_EQ(Q::min(), Q::max() / -Q::epsilon());
+}
+
+TYPED_TEST(TestFixedPoint, DivideByMin)
+{
+  using Q = TypeParam;
+  using rep_type = typename Q::rep_type;
+
+  // min()'s raw value can't be negated in rep_type.
+  EXPECT_EQ(Q{1}, Q::min() / Q::min());
+  EXPECT_EQ(Q{-1}, Q::max() / Q::min());
+  EXPECT_EQ(rep_type{-2}, (Q{1} / Q::min()).raw());
+  EXPECT_EQ(rep_type{2}, (Q{-1} / Q::min()).raw());
+  EXPECT_EQ(Q{}, Q::epsilon() / Q::min());
+}
+
+} // namespace yafiyogi::yy_maths::tests
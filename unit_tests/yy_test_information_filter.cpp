@@ -0,0 +1,77 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "gtest/gtest.h"
+
+#include "yy_information_filter.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestInformationFilter:
+      public testing::Test
+{
+  public:
+    using value_type = information_filter::value_type;
+    using size_type = information_filter::size_type;
+    using matrix = information_filter::matrix;
+    using vector = information_filter::vector;
+    using identity_matrix = information_filter::identity_matrix;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(TestInformationFilter, FailedUpdateKeepsCovariance)
+{
+  constexpr size_type n = 5;
+  const matrix h{identity_matrix{n}};
+  const vector z{n, value_type{1}};
+  const vector hx{n, value_type{}};
+
+  information_filter filter{n, n};
+  information_filter reference{n, n};
+
+  // Negative noise makes P^{-1} + I negative definite, so the second
+  // inversion fails.
+  information_filter::contribution bad{n};
+  bad.add(z, h, hx, vector{n, value_type{-0.5}});
+  EXPECT_FALSE(filter.update(bad));
+
+  // Both filters carry on from the same P.
+  EXPECT_TRUE(filter.update(z, h, hx));
+  EXPECT_TRUE(reference.update(z, h, hx));
+  for(size_type i = 0; i < n; ++i)
+  {
+    EXPECT_EQ(reference.X(i), filter.X(i));
+  }
+}
+
+} // namespace yafiyogi::yy_maths::tests
@@ -0,0 +1,147 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_batch.hpp"
+#include "yy_matrix_util.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestMatrixBatch:
+      public testing::Test
+{
+  public:
+    using size_type = std::size_t;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static bool lane_failed(const batch_mask & p_failed,
+                            size_type p_lane)
+    {
+      return 0 != (p_failed[p_lane / batch_width] & (std::uint64_t{1} << (p_lane % batch_width)));
+    }
+};
+
+TEST_F(TestMatrixBatch, MixedResultsMatchScalar)
+{
+  constexpr size_type n = 5;
+  // More than one block of lanes, the last one partial.
+  constexpr size_type count = 70;
+  constexpr size_type bad_0 = 3;
+  constexpr size_type bad_1 = 66;
+
+  // Lane f: symmetric, f dependent off the diagonal. Positive definite
+  // except for the bad lanes, whose last diagonal element is negative.
+  matrix<double> A{batch_packed_size(n), count};
+  for(size_type f = 0; f < count; ++f)
+  {
+    for(size_type i = 0; i < n; ++i)
+    {
+      for(size_type j = 0; j <= i; ++j)
+      {
+        A(batch_packed_idx(i, j), f) = (i == j)
+          ? static_cast<double>(n + f % 3)
+          : std::sin(static_cast<double>(f + i * n + j));
+      }
+    }
+  }
+  A(batch_packed_idx(n - 1, n - 1), bad_0) = -1.0;
+  A(batch_packed_idx(n - 1, n - 1), bad_1) = -1.0;
+
+  matrix<double> l{A};
+  matrix<double> inv_diag{n, count};
+  batch_mask failed;
+  EXPECT_EQ(2U, batch_cholesky_factor(l, n, inv_diag, failed));
+
+  matrix<double> b{n, count};
+  for(size_type f = 0; f < count; ++f)
+  {
+    for(size_type i = 0; i < n; ++i)
+    {
+      b(i, f) = static_cast<double>(i) - static_cast<double>(f % 4);
+    }
+  }
+  matrix<double> x{b};
+  batch_cholesky_solve(l, inv_diag, n, x);
+
+  for(size_type f = 0; f < count; ++f)
+  {
+    matrix<double> A_f{n, n};
+    for(size_type i = 0; i < n; ++i)
+    {
+      for(size_type j = 0; j < n; ++j)
+      {
+        A_f(i, j) = A(batch_packed_idx(i, j), f);
+      }
+    }
+
+    matrix<double> a_f{n, n};
+    vector<double> p_f{n};
+    const bool ok = cholesky_factor(A_f, a_f, p_f);
+    EXPECT_EQ(!ok, lane_failed(failed, f));
+    EXPECT_EQ((f == bad_0) || (f == bad_1), lane_failed(failed, f));
+    if(!ok)
+    {
+      continue;
+    }
+
+    for(size_type i = 0; i < n; ++i)
+    {
+      EXPECT_NEAR(p_f(i), l(batch_packed_idx(i, i), f), 1e-12);
+      EXPECT_NEAR(1.0 / p_f(i), inv_diag(i, f), 1e-12);
+      for(size_type j = 0; j < i; ++j)
+      {
+        EXPECT_NEAR(a_f(i, j), l(batch_packed_idx(i, j), f), 1e-12);
+      }
+    }
+
+    vector<double> x_f{n};
+    for(size_type i = 0; i < n; ++i)
+    {
+      x_f(i) = b(i, f);
+    }
+    cholesky_solve(a_f, p_f, x_f);
+
+    for(size_type i = 0; i < n; ++i)
+    {
+      EXPECT_NEAR(x_f(i), x(i, f), 1e-12);
+    }
+  }
+}
+
+} // namespace yafiyogi::yy_maths::tests
@@ -0,0 +1,111 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cmath>
+#include <cstddef>
+
+#include "gtest/gtest.h"
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_mixed.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestMatrixMixed:
+      public testing::Test
+{
+  public:
+    using size_type = std::size_t;
+    using matrix = mixed_cholesky<>::matrix;
+    using vector = mixed_cholesky<>::vector;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    // p_scale times a well conditioned symmetric positive definite matrix.
+    static matrix spd(size_type p_size,
+                      double p_scale)
+    {
+      matrix A{p_size, p_size};
+      for(size_type i = 0; i < p_size; ++i)
+      {
+        for(size_type j = 0; j < p_size; ++j)
+        {
+          const double a_ij = (i == j)
+            ? static_cast<double>(p_size)
+            : 1.0 / static_cast<double>(1 + ((i > j) ? i - j : j - i));
+          A(i, j) = p_scale * a_ij;
+        }
+      }
+
+      return A;
+    }
+
+    // b = A x for x_i = i + 1, then solve & check x.
+    static mixed_status solve_and_check(const matrix & p_A)
+    {
+      const size_type size = p_A.size1();
+
+      vector b{size, 0.0};
+      for(size_type i = 0; i < size; ++i)
+      {
+        for(size_type j = 0; j < size; ++j)
+        {
+          b(i) += p_A(i, j) * static_cast<double>(j + 1);
+        }
+      }
+
+      mixed_cholesky<> solver;
+      EXPECT_TRUE(solver.factor(p_A));
+
+      const mixed_status status = solver.solve(b);
+      for(size_type i = 0; i < size; ++i)
+      {
+        EXPECT_TRUE(std::isfinite(b(i)));
+        EXPECT_NEAR(static_cast<double>(i + 1), b(i), 1e-9);
+      }
+
+      return status;
+    }
+};
+
+TEST_F(TestMatrixMixed, InFloatRange)
+{
+  EXPECT_EQ(mixed_status::refined, solve_and_check(spd(16, 1.0)));
+}
+
+TEST_F(TestMatrixMixed, BeyondFloatRange)
+{
+  // Entries above FLT_MAX overflow the float factor.
+  EXPECT_EQ(mixed_status::fallback, solve_and_check(spd(16, 1e39)));
+}
+
+} // namespace yafiyogi::yy_maths::tests
@@ -0,0 +1,111 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstddef>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_parallel.hpp"
+#include "yy_matrix_util.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestMatrixParallel:
+      public testing::Test
+{
+  public:
+    using size_type = std::size_t;
+
+    // Above invert_parallel_min and not a multiple of the tile size.
+    static constexpr size_type size = 600;
+    static constexpr size_type threads = 4;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    // Random off the diagonal, size on it: diagonally dominant, so
+    // symmetric positive definite.
+    static matrix<double> spd()
+    {
+      std::mt19937 gen{7};
+      std::uniform_real_distribution<double> dist{-1.0, 1.0};
+      matrix<double> A{size, size};
+      for(size_type i = 0; i < size; ++i)
+      {
+        A(i, i) = static_cast<double>(size);
+        for(size_type j = 0; j < i; ++j)
+        {
+          A(i, j) = A(j, i) = dist(gen);
+        }
+      }
+
+      return A;
+    }
+};
+
+TEST_F(TestMatrixParallel, InvertMatchesSerial)
+{
+  static_assert(size >= invert_parallel_min);
+  static_assert(0 != (size % matrix_parallel_detail::tile_size));
+
+  const matrix<double> A = spd();
+
+  matrix<double> serial{size, size};
+  vector<double> tmp{size};
+  ASSERT_TRUE(invert(A, serial, tmp));
+
+  matrix<double> parallel{size, size};
+  ASSERT_TRUE(invert(A, parallel, tmp, threads));
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    for(size_type j = 0; j < size; ++j)
+    {
+      EXPECT_NEAR(serial(i, j), parallel(i, j), 1e-12);
+    }
+  }
+}
+
+TEST_F(TestMatrixParallel, InvertNotPositiveDefinite)
+{
+  // A non positive pivot in the last, partial tile.
+  matrix<double> A = spd();
+  A(size - 3, size - 3) = -1.0;
+
+  matrix<double> a{size, size};
+  vector<double> tmp{size};
+  EXPECT_FALSE(invert(A, a, tmp));
+  EXPECT_FALSE(invert(A, a, tmp, threads));
+}
+
+} // namespace yafiyogi::yy_maths::tests
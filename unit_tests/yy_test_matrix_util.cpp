@@ -0,0 +1,291 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstddef>
+#include <memory>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_util.hpp"
+
+namespace yafiyogi::yy_maths::tests {
+
+class TestMatrixUtil:
+      public testing::Test
+{
+  public:
+    using size_type = std::size_t;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    // Symmetric positive definite: p_size on the diagonal, 1 / (1 + |i - j|) off it.
+    template<typename M>
+    static void spd(M & p_m,
+                    size_type p_size)
+    {
+      for(size_type i = 0; i < p_size; ++i)
+      {
+        for(size_type j = 0; j < p_size; ++j)
+        {
+          p_m(i, j) = (i == j)
+            ? static_cast<double>(p_size)
+            : 1.0 / static_cast<double>(1 + ((i > j) ? i - j : j - i));
+        }
+      }
+    }
+
+    // A A^{-1} == I.
+    template<typename M>
+    static void expect_inverse(const M & p_A,
+                               const M & p_inv,
+                               size_type p_size)
+    {
+      for(size_type i = 0; i < p_size; ++i)
+      {
+        for(size_type j = 0; j < p_size; ++j)
+        {
+          double sum = 0.0;
+          for(size_type k = 0; k < p_size; ++k)
+          {
+            sum += p_A(i, k) * p_inv(k, j);
+          }
+          EXPECT_NEAR((i == j) ? 1.0 : 0.0, sum, 1e-12);
+        }
+      }
+    }
+};
+
+TEST_F(TestMatrixUtil, InvertCMatrixBelowCapacity)
+{
+  // Capacity 4, sized 3: the closed form 3 x 3 path.
+  c_matrix<double, 4, 4> A_3{3, 3};
+  spd(A_3, 3);
+  c_matrix<double, 4, 4> inv_3{3, 3};
+  ASSERT_TRUE(invert(A_3, inv_3));
+  expect_inverse(A_3, inv_3, 3);
+
+  // Capacity 6, sized 5: the general Cholesky path.
+  c_matrix<double, 6, 6> A_5{5, 5};
+  spd(A_5, 5);
+  c_matrix<double, 6, 6> inv_5{5, 5};
+  ASSERT_TRUE(invert(A_5, inv_5));
+  expect_inverse(A_5, inv_5, 5);
+
+  // Full capacity: the fixed size path.
+  c_matrix<double, 4, 4> A_4;
+  spd(A_4, 4);
+  c_matrix<double, 4, 4> inv_4;
+  ASSERT_TRUE(invert(A_4, inv_4));
+  expect_inverse(A_4, inv_4, 4);
+
+  // Mismatched sizes are rejected.
+  c_matrix<double, 4, 4> inv_2{2, 2};
+  EXPECT_FALSE(invert(A_3, inv_2));
+}
+
+TEST_F(TestMatrixUtil, InvertCMatrixAboveFixedMax)
+{
+  // Full capacity, too big for the fixed size path, whose N x N stack
+  // scratch would overflow the stack: the general Cholesky path.
+  constexpr size_type size = 768;
+  static_assert(size > matrix_util_detail::invert_fixed_max);
+  using c_matrix_type = c_matrix<double, size, size>;
+
+  auto A = std::make_unique<c_matrix_type>();
+  spd(*A, size);
+  auto inv = std::make_unique<c_matrix_type>();
+  ASSERT_TRUE(invert(*A, *inv));
+
+  // Spot check columns of A A^{-1} == I.
+  for(const size_type j : {size_type{0}, size / 2, size - 1})
+  {
+    for(size_type i = 0; i < size; ++i)
+    {
+      double sum = 0.0;
+      for(size_type k = 0; k < size; ++k)
+      {
+        sum += (*A)(i, k) * (*inv)(k, j);
+      }
+      EXPECT_NEAR((i == j) ? 1.0 : 0.0, sum, 1e-12);
+    }
+  }
+}
+
+TEST_F(TestMatrixUtil, CholeskySolveVector)
+{
+  constexpr size_type size = 6;
+  matrix<double> A{size, size};
+  spd(A, size);
+
+  vector<double> x{size};
+  for(size_type i = 0; i < size; ++i)
+  {
+    x(i) = static_cast<double>(i) - 2.5;
+  }
+  vector<double> b = prod(A, x);
+
+  matrix<double> a{size, size};
+  vector<double> p{size};
+  ASSERT_TRUE(cholesky_factor(A, a, p));
+  cholesky_solve(a, p, b);
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    EXPECT_NEAR(x(i), b(i), 1e-12);
+  }
+
+  // In place factor gives the same result.
+  matrix<double> a_in_place{A};
+  vector<double> p_in_place{size};
+  ASSERT_TRUE(cholesky_factor(a_in_place, p_in_place));
+  b = prod(A, x);
+  cholesky_solve(a_in_place, p_in_place, b);
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    EXPECT_NEAR(x(i), b(i), 1e-12);
+  }
+}
+
+TEST_F(TestMatrixUtil, CholeskySolveMatrix)
+{
+  constexpr size_type size = 6;
+  constexpr size_type columns = 3;
+  matrix<double> A{size, size};
+  spd(A, size);
+
+  matrix<double> X{size, columns};
+  for(size_type i = 0; i < size; ++i)
+  {
+    for(size_type c = 0; c < columns; ++c)
+    {
+      X(i, c) = static_cast<double>(i * columns + c) * 0.25 - 1.0;
+    }
+  }
+  matrix<double> B = prod(A, X);
+
+  matrix<double> a{size, size};
+  vector<double> p{size};
+  ASSERT_TRUE(cholesky_factor(A, a, p));
+  cholesky_solve(a, p, B);
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    for(size_type c = 0; c < columns; ++c)
+    {
+      EXPECT_NEAR(X(i, c), B(i, c), 1e-12);
+    }
+  }
+}
+
+TEST_F(TestMatrixUtil, CholeskyNotPositiveDefinite)
+{
+  // Symmetric, eigenvalues 3 & -1.
+  matrix<double> A{2, 2};
+  A(0, 0) = 1.0;
+  A(0, 1) = 2.0;
+  A(1, 0) = 2.0;
+  A(1, 1) = 1.0;
+
+  matrix<double> a{2, 2};
+  vector<double> p{2};
+  EXPECT_FALSE(cholesky_factor(A, a, p));
+  EXPECT_FALSE(cholesky_factor(A, p));
+
+  // Not square.
+  matrix<double> R{2, 3, 1.0};
+  matrix<double> r{2, 3};
+  EXPECT_FALSE(cholesky_factor(R, r, p));
+}
+
+TEST_F(TestMatrixUtil, CholeskyBlocked)
+{
+  // Above cholesky_blocked_min and not a multiple of cholesky_block.
+  constexpr size_type size = 300;
+  static_assert(size >= matrix_util_detail::cholesky_blocked_min);
+
+  // A = M M^T + size I, M random.
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<double> dist{-1.0, 1.0};
+  matrix<double> M{size, size};
+  for(size_type i = 0; i < size; ++i)
+  {
+    for(size_type j = 0; j < size; ++j)
+    {
+      M(i, j) = dist(gen);
+    }
+  }
+  matrix<double> A = prod(M, trans(M));
+  for(size_type i = 0; i < size; ++i)
+  {
+    A(i, i) += static_cast<double>(size);
+  }
+
+  matrix<double> a{A};
+  vector<double> p{size};
+  ASSERT_TRUE(matrix_util_detail::choldc1(a, p));
+
+  matrix<double> a_unblocked{A};
+  vector<double> p_unblocked{size};
+  ASSERT_TRUE(matrix_util_detail::choldc1_unblocked(a_unblocked, p_unblocked, size));
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    EXPECT_NEAR(p_unblocked(i), p(i), 1e-12);
+    for(size_type j = 0; j < i; ++j)
+    {
+      EXPECT_NEAR(a_unblocked(i, j), a(i, j), 1e-12);
+    }
+  }
+
+  vector<double> x{size};
+  for(size_type i = 0; i < size; ++i)
+  {
+    x(i) = dist(gen);
+  }
+  vector<double> b = prod(A, x);
+  cholesky_solve(a, p, b);
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    EXPECT_NEAR(x(i), b(i), 1e-12);
+  }
+
+  // A late non positive pivot, past the first panels.
+  matrix<double> not_pd{A};
+  not_pd(size - 10, size - 10) = -1.0;
+  EXPECT_FALSE(matrix_util_detail::choldc1(not_pd, p));
+}
+
+} // namespace yafiyogi::yy_maths::tests
@@ -27,34 +27,114 @@
 // Inspired by https://github.com/simondlevy/TinyEKF
 // also https://simondlevy.github.io/ekf-tutorial/
 
-#include "boost/numeric/ublas/operation.hpp"
+#include <cmath>
 
 #include "yy_matrix_util.hpp"
 
 #include "yy_ekf.hpp"
 
 namespace yafiyogi::yy_maths {
+namespace {
 
-ekf::ekf(size_type p_m,
-         size_type p_n) noexcept:
+template<typename M>
+typename M::value_type max_abs_diff(const M & p_a,
+                                    const M & p_b) noexcept
+{
+  using std::abs;
+  using size_type = typename M::size_type;
+
+  typename M::value_type max_diff{};
+  for(size_type i = 0; i < p_a.size1(); ++i)
+  {
+    for(size_type j = 0; j < p_a.size2(); ++j)
+    {
+      max_diff = std::max(max_diff, abs(p_a(i, j) - p_b(i, j)));
+    }
+  }
+
+  return max_diff;
+}
+
+template<typename M>
+bool equal(const M & p_a,
+           const M & p_b) noexcept
+{
+  using size_type = typename M::size_type;
+
+  if((p_a.size1() != p_b.size1()) || (p_a.size2() != p_b.size2()))
+  {
+    return false;
+  }
+
+  for(size_type i = 0; i < p_a.size1(); ++i)
+  {
+    for(size_type j = 0; j < p_a.size2(); ++j)
+    {
+      if(p_a(i, j) != p_b(i, j))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+} // anonymous namespace
+
+template<typename T>
+basic_ekf<T>::workspace::workspace(size_type p_m,
+                                   size_type p_n) noexcept
+{
+  reserve(p_m, p_n);
+}
+
+template<typename T>
+void basic_ekf<T>::workspace::reserve(size_type p_m,
+                                      size_type p_n) noexcept
+{
+  if((m_m == p_m) && (m_n == p_n))
+  {
+    return;
+  }
+
+  m_n = p_n;
+  m_m = p_m;
+  m_FP.resize(m_n, m_n, false);
+  m_Fx.resize(m_n, false);
+  m_HP.resize(m_m, m_n, false);
+  m_HpHtR.resize(m_m, m_m, false);
+  m_W.resize(m_m, m_n, false);
+  m_G.resize(m_n, m_m, false);
+  m_GHP.resize(m_n, m_n, false);
+  m_z_hx.resize(m_m, false);
+  m_v.resize(m_m, false);
+  m_chol.resize(m_m, false);
+  m_PHt_i.resize(m_n, false);
+  m_dx.resize(m_n, false);
+  m_live.reserve(m_m);
+}
+
+template<typename T>
+basic_ekf<T>::basic_ekf(size_type p_m,
+                        size_type p_n) noexcept:
   m_n(p_n),
   m_m(p_m),
   m_x(zero_vector{m_n}),
   m_P(identity_matrix{m_n}),
-  m_R(vector{m_m, EPS}),
-  m_F(m_n)
+  m_R(vector{m_m, EPS})
 {
 }
 
-ekf::ekf(size_type p_m,
-         size_type p_n,
-         const vector & p_r) noexcept:
+template<typename T>
+basic_ekf<T>::basic_ekf(size_type p_m,
+                        size_type p_n,
+                        const vector & p_r) noexcept:
   m_n(p_n),
   m_m(p_m),
   m_x(zero_vector{m_n}),
   m_P(identity_matrix{m_n}),
-  m_R{m_m},
-  m_F(m_n)
+  m_R{m_m}
 {
   vector diagonal_vec{m_m, EPS};
 
@@ -69,24 +149,46 @@ ekf::ekf(size_type p_m,
   m_R.swap(tmp);
 }
 
-ekf::ekf(ekf && other) noexcept:
+template<typename T>
+basic_ekf<T>::basic_ekf(size_type p_m,
+                        size_type p_n,
+                        const vector & p_r,
+                        process_model p_model) noexcept:
+  basic_ekf(p_m, p_n, p_r)
+{
+  m_model = std::move(p_model);
+}
+
+template<typename T>
+basic_ekf<T>::basic_ekf(basic_ekf && other) noexcept:
   m_n(other.m_n),
   m_m(other.m_m),
   m_x(),
   m_P(),
   m_R(),
-  m_F()
+  m_model(std::move(other.m_model)),
+  m_pending(other.m_pending),
+  m_steady(std::move(other.m_steady)),
+  m_cache(std::move(other.m_cache)),
+  m_trigger(other.m_trigger),
+  m_skipped(other.m_skipped),
+  m_gate(other.m_gate),
+  m_rejected(other.m_rejected),
+  m_workspace(std::move(other.m_workspace))
 {
   other.m_n = 0;
   other.m_m = 0;
+  other.m_pending = 0;
+  other.m_skipped = 0;
+  other.m_rejected = 0;
 
   m_x.swap(other.m_x);
   m_P.swap(other.m_P);
   m_R.swap(other.m_R);
-  m_F.swap(other.m_F);
 }
 
-ekf & ekf::operator=(ekf && other) noexcept
+template<typename T>
+basic_ekf<T> & basic_ekf<T>::operator=(basic_ekf && other) noexcept
 {
   if(this != &other)
   {
@@ -101,69 +203,823 @@ ekf & ekf::operator=(ekf && other) noexcept
     m_P.swap(other.m_P);
     m_R = diagonal_matrix_type{};
     m_R.swap(other.m_R);
-    m_F = identity_matrix{};
-    m_F.swap(other.m_F);
+    m_model = std::move(other.m_model);
+    m_workspace = std::move(other.m_workspace);
+    m_pending = other.m_pending;
+    other.m_pending = 0;
+    m_steady = std::move(other.m_steady);
+    m_cache = std::move(other.m_cache);
+    m_trigger = other.m_trigger;
+    m_skipped = other.m_skipped;
+    other.m_skipped = 0;
+    m_gate = other.m_gate;
+    m_rejected = other.m_rejected;
+    other.m_rejected = 0;
   }
   return *this;
 }
 
-void ekf::predict() noexcept
+template<typename T>
+void basic_ekf<T>::model(process_model p_model) noexcept
+{
+  // Pending steps belong to the old model.
+  m_workspace.reserve(m_m, m_n);
+  apply_pending_predicts(m_workspace);
+
+  m_model = std::move(p_model);
+  reset_steady_state();
+  clear_gain_cache();
+}
+
+template<typename T>
+void basic_ekf<T>::R(const vector & p_r) noexcept
+{
+  vector diagonal_vec{m_m};
+
+  for(size_type i = 0; i < m_m; ++i)
+  {
+    diagonal_vec(i) = i < p_r.size() ? p_r(i) : m_R(i, i);
+  }
+
+  diagonal_matrix tmp{diagonal_vec};
+  m_R.swap(tmp);
+
+  reset_steady_state();
+  clear_gain_cache();
+}
+
+template<typename T>
+void basic_ekf<T>::steady_state(value_type p_threshold) noexcept
+{
+  m_steady.threshold = p_threshold;
+  reset_steady_state();
+
+  if(p_threshold > value_type{})
+  {
+    m_steady.H.resize(m_m, m_n, false);
+    m_steady.G.resize(m_n, m_m, false);
+    m_steady.P.resize(m_n, m_n, false);
+    m_steady.L.resize(m_m, m_m, false);
+    m_steady.L_diag.resize(m_m, false);
+  }
+  else
+  {
+    m_steady.H = matrix{};
+    m_steady.G = matrix{};
+    m_steady.P = matrix{};
+    m_steady.L = matrix{};
+    m_steady.L_diag = vector{};
+  }
+}
+
+template<typename T>
+typename basic_ekf<T>::shortcut basic_ekf<T>::update_steady_state(const vector & p_z,
+                                                                  const matrix & p_h,
+                                                                  const vector & p_hx,
+                                                                  workspace & p_workspace) noexcept
 {
   namespace bnu = boost::numeric::ublas;
 
-  matrix FP{m_n, m_n, value_type{}};
+  if((m_pending != m_steady.pending) || !equal(p_h, m_steady.H))
+  {
+    // Frozen P is still the last posterior, so the full update can
+    // carry on from it.
+    reset_steady_state();
+    return shortcut::miss;
+  }
 
-  bnu::axpy_prod(m_F, m_P, FP, false);
+  vector & z_hx = p_workspace.m_z_hx;
+  bnu::noalias(z_hx) = p_z;
+  bnu::noalias(z_hx) -= p_hx;
 
-  const identity_matrix & Ft = m_F; // matrix Ft{bnu::trans(F)} simplified since identity_matrix == trans(identity_matrix);
+  // The prior P, so S, is the same every time.
+  if(gated_out(m_steady.L, m_steady.L_diag, m_m, p_workspace))
+  {
+    return shortcut::rejected;
+  }
 
-  m_P = diagonal_matrix_eps{m_n}; // Add process noise Q.
-  bnu::axpy_prod(FP, Ft, m_P, false);
+  // Predicting then updating P lands back on the same fixed point.
+  m_pending = 0;
+
+  // \hat{x}_k = \hat{x_k} + G(z_k - h(\hat{x}_k))
+  multiply(m_steady.G, z_hx, m_x, false);
+
+  return shortcut::applied;
 }
 
-bool ekf::update(const vector & p_z, // observations m wide
-                 const matrix & p_h, // m x n (m -> inputs, n -> outputs)
-                 const vector & p_hx) noexcept // m wide
+template<typename T>
+void basic_ekf<T>::track_steady_state(const matrix & p_h,
+                                      const workspace & p_workspace,
+                                      size_type p_pending) noexcept
 {
   namespace bnu = boost::numeric::ublas;
 
-  // G_k = P_k H^T_k (H_k P_k H^T_k + R)^{-1}
-  matrix HP{m_m, m_n, value_type{}};
-  bnu::axpy_prod(p_h, m_P, HP, false);
+  if(m_steady.threshold <= value_type{})
+  {
+    return;
+  }
+
+  const matrix & p_G = p_workspace.m_G;
+
+  m_steady.converged = m_steady.primed
+                       && (p_pending == m_steady.pending)
+                       && equal(p_h, m_steady.H)
+                       && (max_abs_diff(p_G, m_steady.G) <= m_steady.threshold)
+                       && (max_abs_diff(m_P, m_steady.P) <= m_steady.threshold);
+
+  bnu::noalias(m_steady.H) = p_h;
+  bnu::noalias(m_steady.G) = p_G;
+  bnu::noalias(m_steady.P) = m_P;
+  bnu::noalias(m_steady.L) = p_workspace.m_HpHtR;
+  bnu::noalias(m_steady.L_diag) = p_workspace.m_chol;
+  m_steady.pending = p_pending;
+  m_steady.primed = true;
+}
 
-  auto Ht{bnu::trans(p_h)};
-  matrix HpHtR{m_R}; // Add R measurement noise.
+template<typename T>
+void basic_ekf<T>::reset_steady_state() noexcept
+{
+  m_steady.converged = false;
+  m_steady.primed = false;
+}
 
-  bnu::axpy_prod(HP, Ht, HpHtR, false);
+template<typename T>
+void basic_ekf<T>::cache_gains(size_type p_capacity,
+                               value_type p_threshold) noexcept
+{
+  m_cache.threshold = p_threshold;
+  m_cache.tick = 0;
+  m_cache.hits = 0;
+  m_cache.misses = 0;
+  m_cache.entries.clear();
+  m_cache.entries.resize(p_capacity);
 
-  matrix HPHtRinv{m_m, m_m};
-  if(!invert(HpHtR, HPHtRinv))
+  for(auto & entry : m_cache.entries)
+  {
+    entry.H.resize(m_m, m_n, false);
+    entry.P_prior.resize(m_n, m_n, false);
+    entry.P.resize(m_n, m_n, false);
+    entry.G.resize(m_n, m_m, false);
+    entry.L.resize(m_m, m_m, false);
+    entry.L_diag.resize(m_m, false);
+  }
+}
+
+template<typename T>
+typename basic_ekf<T>::shortcut basic_ekf<T>::update_cached(const vector & p_z,
+                                                            const matrix & p_h,
+                                                            const vector & p_hx,
+                                                            measurement_mask p_valid,
+                                                            const std::vector<size_type> & p_live,
+                                                            workspace & p_workspace,
+                                                            gain_entry *& p_slot) noexcept
+{
+  namespace bnu = boost::numeric::ublas;
+
+  p_slot = nullptr;
+  if(m_cache.entries.empty())
+  {
+    return shortcut::miss;
+  }
+
+  ++m_cache.tick;
+
+  gain_entry * match = nullptr;
+  gain_entry * victim = &m_cache.entries.front();
+  for(auto & entry : m_cache.entries)
+  {
+    if(entry.valid && (entry.mask == p_valid) && equal(p_h, entry.H))
+    {
+      match = &entry;
+      break;
+    }
+
+    if(victim->valid
+       && (!entry.valid || (entry.last_used < victim->last_used)))
+    {
+      victim = &entry;
+    }
+  }
+
+  if((nullptr != match)
+     && (match->pending == m_pending)
+     && (max_abs_diff(m_P, match->P_prior) <= m_cache.threshold))
+  {
+    const size_type count = p_live.size();
+    vector & z_hx = p_workspace.m_z_hx;
+    for(size_type k = 0; k < count; ++k)
+    {
+      z_hx(k) = p_z(p_live[k]) - p_hx(p_live[k]);
+    }
+
+    if(gated_out(match->L, match->L_diag, count, p_workspace))
+    {
+      return shortcut::rejected;
+    }
+
+    ++m_cache.hits;
+    match->last_used = m_cache.tick;
+
+    // \hat{x}_k = \hat{x_k} + G(z_k - h(\hat{x}_k))
+    for(size_type i = 0; i < m_n; ++i)
+    {
+      value_type dx{};
+      for(size_type k = 0; k < count; ++k)
+      {
+        dx += match->G(i, k) * z_hx(k);
+      }
+      m_x(i) += dx;
+    }
+
+    bnu::noalias(m_P) = match->P;
+    m_pending = 0;
+
+    return shortcut::applied;
+  }
+
+  ++m_cache.misses;
+
+  // Caller fills in G & P once the full update succeeds.
+  p_slot = (nullptr != match) ? match : victim;
+  p_slot->valid = false;
+  p_slot->mask = p_valid;
+  p_slot->pending = m_pending;
+  p_slot->last_used = m_cache.tick;
+  bnu::noalias(p_slot->H) = p_h;
+  bnu::noalias(p_slot->P_prior) = m_P;
+
+  return shortcut::miss;
+}
+
+template<typename T>
+void basic_ekf<T>::clear_gain_cache() noexcept
+{
+  for(auto & entry : m_cache.entries)
+  {
+    entry.valid = false;
+  }
+}
+
+template<typename T>
+void basic_ekf<T>::gate(value_type p_chi2) noexcept
+{
+  m_gate = p_chi2;
+  m_rejected = 0;
+}
+
+// Gate the leading p_size elements of the workspace's z - h(x) against
+// S = L L^T. Counts & returns true for a rejection.
+template<typename T>
+bool basic_ekf<T>::gated_out(const matrix & p_L,
+                             const vector & p_L_diag,
+                             size_type p_size,
+                             workspace & p_workspace) noexcept
+{
+  if(m_gate <= value_type{})
   {
     return false;
   }
 
-  matrix PHt{m_n, m_m, value_type{}};
-  bnu::axpy_prod(m_P, Ht, PHt, false);
+  // d^2 = (z - h(x))^T S^{-1} (z - h(x)) = |L^{-1}(z - h(x))|^2
+  vector & v = p_workspace.m_v;
+  for(size_type i = 0; i < p_size; ++i)
+  {
+    v(i) = p_workspace.m_z_hx(i);
+  }
+  matrix_util_detail::cholfs(p_L, p_L_diag, v, p_size);
+
+  value_type d2{};
+  for(size_type i = 0; i < p_size; ++i)
+  {
+    d2 += v(i) * v(i);
+  }
+
+  if(d2 > m_gate)
+  {
+    ++m_rejected;
+    return true;
+  }
+
+  return false;
+}
 
-  matrix G{m_n, m_m, value_type{}};
-  bnu::axpy_prod(PHt, HPHtRinv, G, false);
+template<typename T>
+bool basic_ekf<T>::factor_gated(workspace & p_workspace) noexcept
+{
+  // Factor H P H^T + R in place.
+  matrix & S = p_workspace.m_HpHtR;
+  vector & L_diag = p_workspace.m_chol;
+  if(!cholesky_factor(S, S, L_diag))
+  {
+    return false;
+  }
+
+  return !gated_out(S, L_diag, m_m, p_workspace);
+}
+
+template<typename T>
+void basic_ekf<T>::apply_gain(workspace & p_workspace) noexcept
+{
+  namespace bnu = boost::numeric::ublas;
+
+  const matrix & HP = p_workspace.m_HP;
+
+  // W = S^{-1} H P by triangular solves, so
+  // G_k = P_k H^T_k S^{-1} = W^T as P & S are symmetric.
+  matrix & W = p_workspace.m_W;
+  bnu::noalias(W) = HP;
+  cholesky_solve(p_workspace.m_HpHtR, p_workspace.m_chol, W);
+
+  matrix & G = p_workspace.m_G;
+  bnu::noalias(G) = bnu::trans(W);
 
   // \hat{x}_k = \hat{x_k} + G_k(z_k - h(\hat{x}_k))
-  vector z_hx{p_z};
+  multiply(G, p_workspace.m_z_hx, m_x, false);
+
+  // P_k = (I - G_k H_k) P_k = P_k - G_k (H P)
+  matrix & GHP = p_workspace.m_GHP;
+  multiply(G, HP, GHP);
+  bnu::noalias(m_P) -= GHP;
+}
+
+template<typename T>
+void basic_ekf<T>::event_trigger(value_type p_threshold) noexcept
+{
+  m_trigger = p_threshold;
+  m_skipped = 0;
+}
+
+template<typename T>
+bool basic_ekf<T>::innovation_below_trigger(const vector & p_z,
+                                            const matrix & p_h,
+                                            const vector & p_hx) const noexcept
+{
+  // d^2 = sum_i (z_i - h(x)_i)^2 / (R_ii + h_i P h_i^T)
+  value_type d2{};
+  for(size_type i = 0; i < m_m; ++i)
+  {
+    value_type s = m_R(i, i);
+    for(size_type r = 0; r < m_n; ++r)
+    {
+      const value_type h_ir = p_h(i, r);
+      if(value_type{} == h_ir)
+      {
+        continue;
+      }
+
+      value_type sum{};
+      for(size_type c = 0; c < m_n; ++c)
+      {
+        sum += m_P(r, c) * p_h(i, c);
+      }
+      s += h_ir * sum;
+    }
+
+    const value_type z_hx = p_z(i) - p_hx(i);
+    d2 += (z_hx * z_hx) / s;
+
+    if(d2 > m_trigger)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template<typename T>
+void basic_ekf<T>::predict(size_type p_steps) noexcept
+{
+  predict(m_workspace, p_steps);
+}
+
+template<typename T>
+void basic_ekf<T>::predict(workspace & p_workspace,
+                           size_type p_steps) noexcept
+{
+  p_workspace.reserve(m_m, m_n);
+
+  std::visit([this, &p_workspace, p_steps](const auto & model) {
+    model.predict_state(m_x, p_steps, p_workspace.m_Fx);
+  }, m_model);
+
+  m_pending += p_steps;
+}
+
+template<typename T>
+void basic_ekf<T>::apply_pending_predicts(workspace & p_workspace) noexcept
+{
+  if(0 == m_pending)
+  {
+    return;
+  }
+
+  std::visit([this, &p_workspace](const auto & model) {
+    model.predict_covariance(m_P, m_pending, p_workspace.m_FP);
+  }, m_model);
+
+  m_pending = 0;
+}
+
+template<typename T>
+bool basic_ekf<T>::update(const vector & p_z, // observations m wide
+                          const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                          const vector & p_hx) noexcept // m wide
+{
+  return update(p_z, p_h, p_hx, m_workspace);
+}
+
+template<typename T>
+bool basic_ekf<T>::update(const vector & p_z, // observations m wide
+                          const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                          const vector & p_hx, // m wide
+                          workspace & p_workspace) noexcept
+{
+  namespace bnu = boost::numeric::ublas;
+
+  p_workspace.reserve(m_m, m_n);
+
+  if((m_trigger > value_type{})
+     && innovation_below_trigger(p_z, p_h, p_hx))
+  {
+    ++m_skipped;
+    return true;
+  }
+
+  if(m_steady.converged)
+  {
+    const shortcut result = update_steady_state(p_z, p_h, p_hx, p_workspace);
+    if(shortcut::miss != result)
+    {
+      return shortcut::applied == result;
+    }
+  }
+
+  gain_entry * slot = nullptr;
+  if(!m_cache.entries.empty())
+  {
+    std::vector<size_type> & live = p_workspace.m_live;
+    live.clear();
+    for(size_type i = 0; i < m_m; ++i)
+    {
+      live.emplace_back(i);
+    }
+
+    const shortcut result = update_cached(p_z, p_h, p_hx, ~measurement_mask{}, live, p_workspace, slot);
+    if(shortcut::miss != result)
+    {
+      return shortcut::applied == result;
+    }
+  }
+
+  const size_type pending = m_pending;
+  apply_pending_predicts(p_workspace);
+
+  // G_k = P_k H^T_k (H_k P_k H^T_k + R)^{-1}
+  matrix & HP = p_workspace.m_HP;
+  multiply(p_h, m_P, HP, true);
+
+  matrix & HpHtR = p_workspace.m_HpHtR;
+  bnu::noalias(HpHtR) = m_R; // Add R measurement noise.
+
+  multiply(HP, bnu::trans(p_h), HpHtR, false);
+
+  vector & z_hx = p_workspace.m_z_hx;
+  bnu::noalias(z_hx) = p_z;
+  bnu::noalias(z_hx) -= p_hx;
+
+  if(!factor_gated(p_workspace))
+  {
+    return false;
+  }
+
+  apply_gain(p_workspace);
+
+  track_steady_state(p_h, p_workspace, pending);
+
+  if(nullptr != slot)
+  {
+    bnu::noalias(slot->G) = p_workspace.m_G;
+    bnu::noalias(slot->P) = m_P;
+    bnu::noalias(slot->L) = p_workspace.m_HpHtR;
+    bnu::noalias(slot->L_diag) = p_workspace.m_chol;
+    slot->valid = true;
+  }
+
+  return true;
+}
+
+template<typename T>
+bool basic_ekf<T>::update(const vector & p_z, // observations m wide
+                          const observation & p_h, // m x n (m -> inputs, n -> outputs)
+                          const vector & p_hx) noexcept // m wide
+{
+  return update(p_z, p_h, p_hx, m_workspace);
+}
+
+template<typename T>
+bool basic_ekf<T>::update(const vector & p_z, // observations m wide
+                          const observation & p_h, // m x n (m -> inputs, n -> outputs)
+                          const vector & p_hx, // m wide
+                          workspace & p_workspace) noexcept
+{
+  namespace bnu = boost::numeric::ublas;
+
+  p_workspace.reserve(m_m, m_n);
+
+  reset_steady_state();
+  apply_pending_predicts(p_workspace);
+
+  // HP = H P: row r of HP gathers the rows of P H selects.
+  matrix & HP = p_workspace.m_HP;
+  for(size_type r = 0; r < m_m; ++r)
+  {
+    for(size_type j = 0; j < m_n; ++j)
+    {
+      HP(r, j) = value_type{};
+    }
+
+    for(auto e = p_h.begin(r), last = p_h.end(r); e != last; ++e)
+    {
+      for(size_type j = 0; j < m_n; ++j)
+      {
+        HP(r, j) += e->weight * m_P(e->column, j);
+      }
+    }
+  }
+
+  // HpHtR = H P H^T + R: gather the columns of HP.
+  matrix & HpHtR = p_workspace.m_HpHtR;
+  for(size_type r = 0; r < m_m; ++r)
+  {
+    for(size_type c = 0; c < m_m; ++c)
+    {
+      value_type sum{};
+      for(auto e = p_h.begin(c), last = p_h.end(c); e != last; ++e)
+      {
+        sum += HP(r, e->column) * e->weight;
+      }
+      HpHtR(r, c) = sum;
+    }
+    HpHtR(r, r) += m_R(r, r);
+  }
+
+  vector & z_hx = p_workspace.m_z_hx;
+  bnu::noalias(z_hx) = p_z;
   bnu::noalias(z_hx) -= p_hx;
 
-  bnu::axpy_prod(G, z_hx, m_x, false);
+  if(!factor_gated(p_workspace))
+  {
+    return false;
+  }
+
+  // G_k = P_k H^T_k (H_k P_k H^T_k + R)^{-1} = (S^{-1} H P)^T
+  apply_gain(p_workspace);
+
+  return true;
+}
+
+template<typename T>
+bool basic_ekf<T>::update(const vector & p_z, // observations m wide
+                          const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                          const vector & p_hx, // m wide
+                          measurement_mask p_valid) noexcept
+{
+  return update(p_z, p_h, p_hx, p_valid, m_workspace);
+}
+
+template<typename T>
+bool basic_ekf<T>::update(const vector & p_z, // observations m wide
+                          const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                          const vector & p_hx, // m wide
+                          measurement_mask p_valid,
+                          workspace & p_workspace) noexcept
+{
+  p_workspace.reserve(m_m, m_n);
+
+  std::vector<size_type> & live = p_workspace.m_live;
+  live.clear();
+
+  constexpr size_type mask_bits = sizeof(measurement_mask) * 8;
+  const size_type rows = std::min(m_m, mask_bits);
+  for(size_type i = 0; i < rows; ++i)
+  {
+    if(0 != ((p_valid >> i) & measurement_mask{1}))
+    {
+      live.emplace_back(i);
+    }
+  }
+
+  const size_type count = live.size();
+  if(0 == count)
+  {
+    return true; // Nothing observed.
+  }
+
+  if(m_m == count)
+  {
+    return update(p_z, p_h, p_hx, p_workspace);
+  }
+
+  reset_steady_state();
+
+  gain_entry * slot = nullptr;
+  const shortcut result = update_cached(p_z, p_h, p_hx, p_valid, live, p_workspace, slot);
+  if(shortcut::miss != result)
+  {
+    return shortcut::applied == result;
+  }
+
+  apply_pending_predicts(p_workspace);
+
+  // HP = H P, live rows only, packed at the top.
+  matrix & HP = p_workspace.m_HP;
+  for(size_type l = 0; l < count; ++l)
+  {
+    const size_type r = live[l];
+    for(size_type j = 0; j < m_n; ++j)
+    {
+      value_type sum{};
+      for(size_type k = 0; k < m_n; ++k)
+      {
+        sum += p_h(r, k) * m_P(k, j);
+      }
+      HP(l, j) = sum;
+    }
+  }
+
+  // S = H P H^T + R, leading count x count block, upper triangle.
+  matrix & S = p_workspace.m_HpHtR;
+  for(size_type l = 0; l < count; ++l)
+  {
+    for(size_type c = l; c < count; ++c)
+    {
+      const size_type r = live[c];
+      value_type sum{};
+      for(size_type k = 0; k < m_n; ++k)
+      {
+        sum += HP(l, k) * p_h(r, k);
+      }
+      S(l, c) = sum;
+    }
+    S(l, l) += m_R(live[l], live[l]);
+  }
+
+  vector & L_diag = p_workspace.m_chol;
+  if(!matrix_util_detail::choldc1(S, L_diag, count))
+  {
+    return false;
+  }
+
+  // Y = L^{-1} H P, v = L^{-1}(z - h(x)), over the live rows.
+  vector & v = p_workspace.m_z_hx;
+  for(size_type l = 0; l < count; ++l)
+  {
+    v(l) = p_z(live[l]) - p_hx(live[l]);
+  }
+  matrix_util_detail::cholfs(S, L_diag, v, count);
+  matrix_util_detail::cholfs_rows(S, L_diag, HP, count);
+
+  // d^2 = v^T v
+  if(m_gate > value_type{})
+  {
+    value_type d2{};
+    for(size_type l = 0; l < count; ++l)
+    {
+      d2 += v(l) * v(l);
+    }
+
+    if(d2 > m_gate)
+    {
+      ++m_rejected;
+      return false;
+    }
+  }
 
-  // P_k = (I - G_k H_k) P_k
-  matrix GH{diagonal_matrix_neg{m_n}};
-  bnu::axpy_prod(G, p_h, GH, false);
-  GH *= -1.0; // negate
+  const matrix & Y = HP;
 
-  matrix GHP{m_n, m_n, value_type{}};
-  bnu::axpy_prod(GH, m_P, GHP, false);
-  m_P.swap(GHP);
+  // G = P H^T S^{-1} = Y^T L^{-1}, so
+  // \hat{x}_k = \hat{x_k} + Y^T v
+  // P_k = P_k - G H P = P_k - Y^T Y
+  for(size_type i = 0; i < m_n; ++i)
+  {
+    value_type dx{};
+    for(size_type k = 0; k < count; ++k)
+    {
+      dx += Y(k, i) * v(k);
+    }
+    m_x(i) += dx;
+
+    for(size_type j = i; j < m_n; ++j)
+    {
+      value_type sum{};
+      for(size_type k = 0; k < count; ++k)
+      {
+        sum += Y(k, i) * Y(k, j);
+      }
+      m_P(i, j) -= sum;
+      m_P(j, i) = m_P(i, j);
+    }
+  }
+
+  if(nullptr != slot)
+  {
+    // G^T = L^{-T} Y
+    for(size_type i = 0; i < m_n; ++i)
+    {
+      for(size_type k = count; k-- > 0;)
+      {
+        value_type g_ik = Y(k, i);
+        for(size_type j = k + 1; j < count; ++j)
+        {
+          g_ik -= S(j, k) * slot->G(i, j);
+        }
+        slot->G(i, k) = g_ik / L_diag(k);
+      }
+    }
+
+    boost::numeric::ublas::noalias(slot->P) = m_P;
+    boost::numeric::ublas::noalias(slot->L) = S;
+    boost::numeric::ublas::noalias(slot->L_diag) = L_diag;
+    slot->valid = true;
+  }
 
   return true;
 }
 
+template<typename T>
+void basic_ekf<T>::update_sequential(const vector & p_z, // observations m wide
+                                     const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                                     const vector & p_hx) noexcept // m wide
+{
+  update_sequential(p_z, p_h, p_hx, m_workspace);
+}
+
+template<typename T>
+void basic_ekf<T>::update_sequential(const vector & p_z, // observations m wide
+                                     const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                                     const vector & p_hx, // m wide
+                                     workspace & p_workspace) noexcept
+{
+  p_workspace.reserve(m_m, m_n);
+
+  reset_steady_state();
+  apply_pending_predicts(p_workspace);
+
+  vector & PHt = p_workspace.m_PHt_i;
+  vector & dx = p_workspace.m_dx;
+  dx.clear();
+
+  for(size_type i = 0; i < m_m; ++i)
+  {
+    // PHt = P h_i^T, s = h_i P h_i^T + r_i
+    value_type s = m_R(i, i);
+    for(size_type r = 0; r < m_n; ++r)
+    {
+      value_type sum{};
+      for(size_type c = 0; c < m_n; ++c)
+      {
+        sum += m_P(r, c) * p_h(i, c);
+      }
+      PHt(r) = sum;
+      s += p_h(i, r) * sum;
+    }
+
+    if(s <= value_type{})
+    {
+      continue; // Measurement carries no information.
+    }
+
+    // Innovation against the state as corrected by earlier measurements.
+    value_type z_hx = p_z(i) - p_hx(i);
+    for(size_type c = 0; c < m_n; ++c)
+    {
+      z_hx -= p_h(i, c) * dx(c);
+    }
+
+    // g = P h_i^T / s, x += g z_hx, P -= g (P h_i^T)^T
+    const value_type s_inv = value_type{1} / s;
+    for(size_type r = 0; r < m_n; ++r)
+    {
+      const value_type g_r = PHt(r) * s_inv;
+      dx(r) += g_r * z_hx;
+
+      for(size_type c = r; c < m_n; ++c)
+      {
+        m_P(r, c) -= g_r * PHt(c);
+        m_P(c, r) = m_P(r, c);
+      }
+    }
+  }
+
+  namespace bnu = boost::numeric::ublas;
+
+  bnu::noalias(m_x) += dx;
+}
+
+template class basic_ekf<float>;
+template class basic_ekf<double>;
+template class basic_ekf<q16_16>;
+template class basic_ekf<q32_32>;
+
 } // namespace yafiyogi::yy_maths
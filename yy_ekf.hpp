@@ -38,41 +38,190 @@
 #define BOOST_UBLAS_MOVE_SEMANTICS
 #define BOOST_UBLAS_NDEBUG
 
+#include <cstdint>
+#include <variant>
+#include <vector>
+
 #include "yy_diagonal_matrix.hpp"
+#include "yy_ekf_process_model.hpp"
+#include "yy_fixed_point.hpp"
 #include "yy_matrix.hpp"
+#include "yy_sparse_observation.hpp"
 
 namespace yafiyogi::yy_maths {
 
-class ekf final
+// T is the scalar type: double, or float where single precision is
+// enough, which halves the memory footprint and doubles the elements per
+// vector instruction, or q16_16/q32_32 fixed point (yy_fixed_point.hpp)
+// for results that are bit identical on every platform. These four are
+// compiled into the library.
+template<typename T>
+class basic_ekf final
 {
   public:
-    using value_type = double;
-    static constexpr value_type EPS = 1e-4;
+    using value_type = T;
+    static constexpr value_type EPS = static_cast<value_type>(1e-4);
 
     using matrix = yy_maths::matrix<value_type>;
     using identity_matrix = yy_maths::identity_matrix<value_type>;
     using diagonal_matrix_eps = diagonal_matrix_fixed<value_type, EPS>;
-    using diagonal_matrix_neg = diagonal_matrix_fixed<value_type, -1.0>;
+    using diagonal_matrix_neg = diagonal_matrix_fixed<value_type, static_cast<value_type>(-1)>;
     using diagonal_matrix_type = diagonal_matrix<value_type>;
     using zero_matrix = yy_maths::zero_matrix<value_type>;
     using vector = yy_maths::vector<value_type>;
     using zero_vector = yy_maths::zero_vector<value_type>;
-    using size_type = matrix::size_type;
+    using size_type = typename matrix::size_type;
+    using identity_model = identity_process_model<value_type>;
+    using constant_velocity_model = constant_velocity_process_model<value_type>;
+    using dense_model = dense_process_model<value_type>;
+    using process_model = std::variant<identity_model,
+                                       constant_velocity_model,
+                                       dense_model>;
+    using observation = sparse_observation<value_type>;
+    using measurement_mask = std::uint64_t; // Bit i set if z(i) is valid.
+
+    // Scratch used by predict() & update(). Sized once for (m, n) and reused,
+    // so steady state filtering does no allocation. Either let the filter
+    // use its own, or pass one in (e.g. one per thread shared by many filters).
+    // A passed in workspace is resized to the filter using it, so sharing
+    // one between filters of different sizes is safe but reallocates.
+    class workspace final
+    {
+      public:
+        constexpr workspace() noexcept = default;
+        workspace(size_type p_m, size_type p_n) noexcept;
+        workspace(const workspace & other) noexcept = default;
+        workspace(workspace && other) noexcept = default;
+
+        workspace & operator=(const workspace & other) noexcept = default;
+        workspace & operator=(workspace && other) noexcept = default;
+
+        void reserve(size_type p_m, size_type p_n) noexcept;
+
+      private:
+        friend class basic_ekf;
+
+        size_type m_n = 0;
+        size_type m_m = 0;
+        matrix m_FP{};       // n x n
+        vector m_Fx{};       // n
+        matrix m_HP{};       // m x n
+        matrix m_HpHtR{};    // m x m, S = H P H^T + R & its factor.
+        matrix m_W{};        // m x n, S^{-1} H P
+        matrix m_G{};        // n x m
+        matrix m_GHP{};      // n x n
+        vector m_z_hx{};     // m
+        vector m_v{};        // m, L^{-1}(z - h(x)) for gating.
+        vector m_chol{};     // m
+        vector m_PHt_i{};    // n, P h_i^T of one measurement row.
+        vector m_dx{};       // n, accumulated state correction.
+        std::vector<size_type> m_live{}; // m, indices of valid measurements.
+    };
+
+    basic_ekf(size_type p_m, size_type p_n) noexcept;
+    basic_ekf(size_type p_m, size_type p_n, const vector & p_r) noexcept;
+    basic_ekf(size_type p_m, size_type p_n, const vector & p_r, process_model p_model) noexcept;
 
-    ekf(size_type p_m, size_type p_n) noexcept;
-    ekf(size_type p_m, size_type p_n, const vector & p_r) noexcept;
+    constexpr basic_ekf() noexcept = default;
+    basic_ekf(const basic_ekf & other) noexcept = default;
+    basic_ekf(basic_ekf && other) noexcept;
 
-    constexpr ekf() noexcept = default;
-    ekf(const ekf & other) noexcept = default;
-    ekf(ekf && other) noexcept;
+    basic_ekf & operator=(const basic_ekf & other) noexcept = default;
+    basic_ekf & operator=(basic_ekf && other) noexcept;
 
-    ekf & operator=(const ekf & other) noexcept = default;
-    ekf & operator=(ekf && other) noexcept;
+    // Defaults to F == I, Q = EPS I.
+    void model(process_model p_model) noexcept;
 
-    void predict() noexcept;
+    // Set the (diagonal) measurement noise.
+    void R(const vector & p_r) noexcept;
+
+    // With constant H, R & predict rate G & P converge. Once successive
+    // updates move no element of G or P by more than p_threshold, they are
+    // frozen and update() reduces to x += G (z - h(x)). Falls back to the
+    // full update if H, R, the model or the number of predicts between
+    // updates changes. A threshold <= 0 (the default) disables this.
+    void steady_state(value_type p_threshold) noexcept;
+
+    // Memo of gains for up to p_capacity observation patterns (H & mask),
+    // least recently used evicted first. A dense or masked update whose
+    // pattern, predict count & prior P (to within p_threshold) match an
+    // entry reuses its gain & posterior P: x += G (z - h(x)), skipping
+    // H P H^T, the factorisation & the covariance update. Otherwise the
+    // update runs in full and refreshes the entry. Useful when a device
+    // cycles through a few patterns, so each one's prior P settles.
+    // A capacity of 0 (the default) disables the memo.
+    void cache_gains(size_type p_capacity,
+                     value_type p_threshold) noexcept;
+
+    // Event triggered updates. A dense update first computes the
+    // normalised innovation
+    //   d^2 = sum_i (z_i - h(x)_i)^2 / (R_ii + h_i P h_i^T)
+    // in O(m n^2), and only runs the full update when d^2 > p_threshold.
+    // P excludes pending predicts, so d^2 errs on the side of updating.
+    // A threshold <= 0 (the default) disables this.
+    void event_trigger(value_type p_threshold) noexcept;
+
+    // Chi-square gating. The dense, sparse & masked updates reject
+    // measurements whose Mahalanobis distance
+    //   d^2 = (z - h(x))^T S^{-1} (z - h(x)), S = H P H^T + R
+    // exceeds p_chi2 (e.g. 11.34 for 99% with 3 measurements), returning
+    // false with x & P untouched. d^2 comes from a forward solve against
+    // the Cholesky factor of S the update needs anyway, so it costs
+    // O(m^2), and rejection skips the gain & covariance products.
+    // Steady state & cached gain updates are gated too, against the
+    // factor of S kept with their gain.
+    // A value <= 0 (the default) disables gating.
+    void gate(value_type p_chi2) noexcept;
+
+    // Prediction is lazy: the state is advanced straight away, but the
+    // covariance steps are only counted and then applied in one go on the
+    // next update. An idle filter costs (next to) nothing between readings.
+    void predict(size_type p_steps = 1) noexcept;
+    void predict(workspace & p_workspace,
+                 size_type p_steps = 1) noexcept;
     bool update(const vector & p_z, // observations m wide
                 const matrix & p_h, // m x n (m -> inputs, n -> outputs)
                 const vector & p_hx) noexcept; // m wide
+    bool update(const vector & p_z, // observations m wide
+                const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector & p_hx, // m wide
+                workspace & p_workspace) noexcept;
+
+    // As above, with H given as (state index, weight) rows. H P & H P H^T
+    // become gathers costing O(nnz n) & O(nnz m), and G = (H P)^T S^{-1}
+    // as P is symmetric.
+    bool update(const vector & p_z, // observations m wide
+                const observation & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector & p_hx) noexcept; // m wide
+    bool update(const vector & p_z, // observations m wide
+                const observation & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector & p_hx, // m wide
+                workspace & p_workspace) noexcept;
+
+    // As update(), using only the measurements whose bit is set in p_valid
+    // (so at most the first 64). Only the observed rows of H are used and
+    // only the live sub-block of H P H^T + R is factored; no need to swap
+    // in a different H or fake a missing z.
+    bool update(const vector & p_z, // observations m wide
+                const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector & p_hx, // m wide
+                measurement_mask p_valid) noexcept;
+    bool update(const vector & p_z, // observations m wide
+                const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector & p_hx, // m wide
+                measurement_mask p_valid,
+                workspace & p_workspace) noexcept;
+
+    // Process each measurement as a scalar update. Needs no matrix
+    // inversion as R is diagonal, so is O(m n^2) rather than O(m^3),
+    // and can't fail on a non positive definite H P H^T + R.
+    void update_sequential(const vector & p_z, // observations m wide
+                           const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                           const vector & p_hx) noexcept; // m wide
+    void update_sequential(const vector & p_z, // observations m wide
+                           const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                           const vector & p_hx, // m wide
+                           workspace & p_workspace) noexcept;
 
     const vector & X() const noexcept
     {
@@ -84,6 +233,12 @@ class ekf final
       return m_x(idx);
     }
 
+    // Covariance (pending predicts not applied).
+    const matrix & P() const noexcept
+    {
+      return m_P;
+    }
+
     constexpr size_type N() const noexcept
     {
       return m_n;
@@ -94,13 +249,131 @@ class ekf final
       return m_m;
     }
 
+    constexpr size_type pending_predicts() const noexcept
+    {
+      return m_pending;
+    }
+
+    constexpr bool steady() const noexcept
+    {
+      return m_steady.converged;
+    }
+
+    constexpr size_type cache_hits() const noexcept
+    {
+      return m_cache.hits;
+    }
+
+    constexpr size_type cache_misses() const noexcept
+    {
+      return m_cache.misses;
+    }
+
+    constexpr size_type skipped_updates() const noexcept
+    {
+      return m_skipped;
+    }
+
+    constexpr size_type rejected_updates() const noexcept
+    {
+      return m_rejected;
+    }
+
   private:
+    // G & P of the last full update, to detect convergence.
+    struct steady_gain final
+    {
+        value_type threshold{};
+        bool converged = false;
+        bool primed = false; // H, G, P & pending hold a previous update.
+        size_type pending = 0;
+        matrix H{}; // m x n
+        matrix G{}; // n x m
+        matrix P{}; // n x n
+        matrix L{}; // m x m, Cholesky factor of S (lower triangle).
+        vector L_diag{}; // m, diagonal of L.
+    };
+
+    // Gain & posterior P for one observation pattern.
+    struct gain_entry final
+    {
+        bool valid = false;
+        measurement_mask mask{};
+        size_type pending = 0;
+        size_type last_used = 0;
+        matrix H{};       // m x n
+        matrix P_prior{}; // n x n, before pending predicts.
+        matrix P{};       // n x n, posterior.
+        matrix G{};       // n x m, columns are the live measurements.
+        matrix L{};       // m x m, factor of S over the live measurements.
+        vector L_diag{};  // m, diagonal of L.
+    };
+
+    struct gain_memo final
+    {
+        value_type threshold{};
+        size_type tick = 0;
+        size_type hits = 0;
+        size_type misses = 0;
+        std::vector<gain_entry> entries{};
+    };
+
+    // Outcome of a steady state or cached gain update.
+    enum class shortcut
+    {
+      miss,     // Run the full update.
+      applied,  // x (& P) updated from the stored gain.
+      rejected  // Gated out, x & P untouched.
+    };
+
+    void apply_pending_predicts(workspace & p_workspace) noexcept;
+    shortcut update_cached(const vector & p_z,
+                           const matrix & p_h,
+                           const vector & p_hx,
+                           measurement_mask p_valid,
+                           const std::vector<size_type> & p_live,
+                           workspace & p_workspace,
+                           gain_entry *& p_slot) noexcept;
+    void clear_gain_cache() noexcept;
+    bool gated_out(const matrix & p_L,
+                   const vector & p_L_diag,
+                   size_type p_size,
+                   workspace & p_workspace) noexcept;
+    bool factor_gated(workspace & p_workspace) noexcept;
+    void apply_gain(workspace & p_workspace) noexcept;
+    bool innovation_below_trigger(const vector & p_z,
+                                  const matrix & p_h,
+                                  const vector & p_hx) const noexcept;
+    shortcut update_steady_state(const vector & p_z,
+                                 const matrix & p_h,
+                                 const vector & p_hx,
+                                 workspace & p_workspace) noexcept;
+    void track_steady_state(const matrix & p_h,
+                            const workspace & p_workspace,
+                            size_type p_pending) noexcept;
+    void reset_steady_state() noexcept;
+
     size_type m_n = 0;          // Number of outputs
     size_type m_m = 0;          // Number of inputs
     vector m_x{};               // State vector.
     matrix m_P{};               // Prediction error covariance
     diagonal_matrix_type m_R{}; // Measurement noise.
-    identity_matrix m_F{};      // Process model Jacobian is identity matrix
+    process_model m_model{identity_model{EPS}}; // Process model Jacobian & noise.
+    size_type m_pending = 0;    // Covariance predictions not yet applied.
+    steady_gain m_steady{};     // Frozen gain once converged.
+    gain_memo m_cache{};        // Gains per observation pattern.
+    value_type m_trigger{};     // Event trigger threshold on d^2.
+    size_type m_skipped = 0;    // Updates skipped by the event trigger.
+    value_type m_gate{};        // Chi-square gate on d^2.
+    size_type m_rejected = 0;   // Updates rejected by the gate.
+    workspace m_workspace{};    // Scratch when caller doesn't supply one.
 };
 
+extern template class basic_ekf<float>;
+extern template class basic_ekf<double>;
+extern template class basic_ekf<q16_16>;
+extern template class basic_ekf<q32_32>;
+
+using ekf = basic_ekf<double>;
+
 } // namespace yafiyogi::yy_maths
@@ -0,0 +1,351 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// A bank of ekf_fixed<M, N> filters sharing the same observation model H.
+// State is stored structure of arrays: each row of m_x, m_P & m_R holds one
+// element for every filter, so the innermost loops run across filters over
+// contiguous memory and vectorise (one SIMD lane per filter).
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_batch.hpp"
+
+namespace yafiyogi::yy_maths {
+
+template<std::size_t Inputs,
+         std::size_t Outputs,
+         typename T = double>
+class ekf_bank final
+{
+  public:
+    static_assert((Inputs > 0) && (Outputs > 0), "ekf_bank dimensions must be non-zero");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    static constexpr value_type EPS = value_type{1e-4};
+    static constexpr size_type m = Inputs;  // Number of inputs
+    static constexpr size_type n = Outputs; // Number of outputs
+    static constexpr size_type block_size = batch_width; // Filters processed together.
+
+    using matrix = yy_maths::matrix<value_type>;
+    using vector_m = yy_maths::c_vector<value_type, m>;
+    using matrix_mn = yy_maths::c_matrix<value_type, m, n>;
+
+    constexpr ekf_bank() noexcept = default;
+
+    explicit ekf_bank(size_type p_count) noexcept:
+      m_count(p_count),
+      m_x(n, m_count, value_type{}),
+      m_P(batch_packed_size(n), m_count, value_type{}),
+      m_R(m, m_count, EPS)
+    {
+      for(size_type i = 0; i < n; ++i)
+      {
+        value_type * P_ii = row(m_P, batch_packed_idx(i, i));
+        for(size_type f = 0; f < m_count; ++f)
+        {
+          P_ii[f] = value_type{1};
+        }
+      }
+    }
+
+    ekf_bank(size_type p_count,
+             const vector_m & p_r) noexcept:
+      ekf_bank(p_count)
+    {
+      for(size_type f = 0; f < m_count; ++f)
+      {
+        R(f, p_r);
+      }
+    }
+
+    ekf_bank(const ekf_bank & other) noexcept = default;
+    ekf_bank(ekf_bank && other) noexcept = default;
+
+    ekf_bank & operator=(const ekf_bank & other) noexcept = default;
+    ekf_bank & operator=(ekf_bank && other) noexcept = default;
+
+    // Set measurement noise (diagonal) of one filter.
+    void R(size_type p_filter,
+           const vector_m & p_r) noexcept
+    {
+      for(size_type i = 0; i < m; ++i)
+      {
+        m_R(i, p_filter) = p_r(i);
+      }
+    }
+
+    void predict() noexcept
+    {
+      // P_k = F P_{k-1} F^T + Q, with F == I and Q == EPS I.
+      for(size_type i = 0; i < n; ++i)
+      {
+        value_type * P_ii = row(m_P, batch_packed_idx(i, i));
+        for(size_type f = 0; f < m_count; ++f)
+        {
+          P_ii[f] += EPS;
+        }
+      }
+    }
+
+    // p_z & p_hx are m x count, one column per filter. Filters whose
+    // H P H^T + R isn't positive definite are left untouched.
+    // Returns the number of filters updated.
+    size_type update(const matrix & p_z,
+                     const matrix_mn & p_h,
+                     const matrix & p_hx) noexcept
+    {
+      size_type updated = 0;
+
+      for(size_type first = 0; first < m_count; first += block_size)
+      {
+        const size_type width = std::min(block_size, m_count - first);
+
+        updated += update_block(first, width, p_z, p_h, p_hx);
+      }
+
+      return updated;
+    }
+
+    const matrix & X() const noexcept
+    {
+      return m_x;
+    }
+
+    const value_type & X(size_type p_filter,
+                         size_type idx) const noexcept
+    {
+      return m_x(idx, p_filter);
+    }
+
+    // Element (i, j) of one filter's covariance.
+    const value_type & P(size_type p_filter,
+                         size_type i,
+                         size_type j) const noexcept
+    {
+      return m_P(batch_packed_idx(i, j), p_filter);
+    }
+
+    static constexpr size_type N() noexcept
+    {
+      return n;
+    }
+
+    static constexpr size_type M() noexcept
+    {
+      return m;
+    }
+
+    constexpr size_type size() const noexcept
+    {
+      return m_count;
+    }
+
+  private:
+    using block = std::array<value_type, block_size>;
+
+    static value_type * row(matrix & p_matrix,
+                            size_type p_row) noexcept
+    {
+      return &p_matrix.data()[p_row * p_matrix.size2()];
+    }
+
+    static const value_type * row(const matrix & p_matrix,
+                                  size_type p_row) noexcept
+    {
+      return &p_matrix.data()[p_row * p_matrix.size2()];
+    }
+
+    size_type update_block(size_type p_first,
+                           size_type p_width,
+                           const matrix & p_z,
+                           const matrix_mn & p_h,
+                           const matrix & p_hx) noexcept
+    {
+      // HP = H P
+      std::array<block, m * n> HP;
+      for(size_type i = 0; i < m; ++i)
+      {
+        for(size_type j = 0; j < n; ++j)
+        {
+          block & HP_ij = HP[i * n + j];
+          HP_ij.fill(value_type{});
+
+          for(size_type k = 0; k < n; ++k)
+          {
+            const value_type h_ik = p_h(i, k);
+            if(h_ik == value_type{})
+            {
+              continue;
+            }
+
+            const value_type * P_kj = row(m_P, batch_packed_idx(k, j)) + p_first;
+            for(size_type f = 0; f < p_width; ++f)
+            {
+              HP_ij[f] += h_ik * P_kj[f];
+            }
+          }
+        }
+      }
+
+      // S = H P H^T + R, lower triangle.
+      std::array<block, batch_packed_size(m)> S;
+      for(size_type i = 0; i < m; ++i)
+      {
+        for(size_type j = 0; j <= i; ++j)
+        {
+          block & S_ij = S[batch_packed_idx(i, j)];
+          S_ij.fill(value_type{});
+
+          for(size_type k = 0; k < n; ++k)
+          {
+            const value_type h_jk = p_h(j, k);
+            if(h_jk == value_type{})
+            {
+              continue;
+            }
+
+            const block & HP_ik = HP[i * n + k];
+            for(size_type f = 0; f < p_width; ++f)
+            {
+              S_ij[f] += HP_ik[f] * h_jk;
+            }
+          }
+        }
+
+        block & S_ii = S[batch_packed_idx(i, i)];
+        const value_type * R_i = row(m_R, i) + p_first;
+        for(size_type f = 0; f < p_width; ++f)
+        {
+          S_ii[f] += R_i[f];
+        }
+      }
+
+      // Cholesky, S = L L^T, one lane per filter. A failing lane carries on
+      // with a dummy pivot and is masked out at the end.
+      std::array<block, m> inv_diag;
+      const auto S_rows = [&S](size_type p_idx) {
+        return S[p_idx].data();
+      };
+      const auto inv_diag_rows = [&inv_diag](size_type p_idx) {
+        return inv_diag[p_idx].data();
+      };
+
+      const std::uint64_t failed = matrix_batch_detail::choldc1(S_rows, inv_diag_rows, m, p_width);
+
+      std::array<bool, block_size> ok;
+      for(size_type f = 0; f < block_size; ++f)
+      {
+        ok[f] = ((failed >> f) & 1) == 0;
+      }
+
+      // W = S^{-1} H P, G = W^T.
+      std::array<block, m * n> W{HP};
+      for(size_type c = 0; c < n; ++c)
+      {
+        matrix_batch_detail::cholsl(S_rows,
+                                    inv_diag_rows,
+                                    [&W, c](size_type p_idx) {
+                                      return W[p_idx * n + c].data();
+                                    },
+                                    m,
+                                    p_width);
+      }
+
+      // \hat{x}_k = \hat{x_k} + G_k(z_k - h(\hat{x}_k))
+      std::array<block, m> z_hx;
+      for(size_type i = 0; i < m; ++i)
+      {
+        const value_type * z_i = row(p_z, i) + p_first;
+        const value_type * hx_i = row(p_hx, i) + p_first;
+        block & z_hx_i = z_hx[i];
+        for(size_type f = 0; f < p_width; ++f)
+        {
+          z_hx_i[f] = ok[f] ? (z_i[f] - hx_i[f]) : value_type{};
+        }
+      }
+
+      for(size_type j = 0; j < n; ++j)
+      {
+        value_type * x_j = row(m_x, j) + p_first;
+        for(size_type k = 0; k < m; ++k)
+        {
+          const block & W_kj = W[k * n + j];
+          const block & z_hx_k = z_hx[k];
+          for(size_type f = 0; f < p_width; ++f)
+          {
+            x_j[f] += W_kj[f] * z_hx_k[f];
+          }
+        }
+      }
+
+      // P_k = P_k - (H P)^T W, lower triangle.
+      for(size_type i = 0; i < n; ++i)
+      {
+        for(size_type j = 0; j <= i; ++j)
+        {
+          block GHP;
+          GHP.fill(value_type{});
+          for(size_type k = 0; k < m; ++k)
+          {
+            const block & HP_ki = HP[k * n + i];
+            const block & W_kj = W[k * n + j];
+            for(size_type f = 0; f < p_width; ++f)
+            {
+              GHP[f] += HP_ki[f] * W_kj[f];
+            }
+          }
+
+          value_type * P_ij = row(m_P, batch_packed_idx(i, j)) + p_first;
+          for(size_type f = 0; f < p_width; ++f)
+          {
+            P_ij[f] -= ok[f] ? GHP[f] : value_type{};
+          }
+        }
+      }
+
+      size_type updated = 0;
+      for(size_type f = 0; f < p_width; ++f)
+      {
+        updated += ok[f] ? 1 : 0;
+      }
+
+      return updated;
+    }
+
+    size_type m_count = 0;
+    matrix m_x{}; // n x count, state vectors.
+    matrix m_P{}; // n(n+1)/2 x count, packed lower covariance.
+    matrix m_R{}; // m x count, measurement noise (diagonal).
+};
+
+} // namespace yafiyogi::yy_maths
@@ -0,0 +1,216 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Compile time sized version of ekf (see yy_ekf.hpp).
+// Everything lives in c_matrix/c_vector inline storage so predict() and
+// update() never touch the heap, and the loops have constant trip counts
+// the compiler can unroll. S is factored & solved by the yy_matrix_util.hpp
+// Cholesky kernels.
+
+#pragma once
+
+#include <cstddef>
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_util.hpp"
+
+namespace yafiyogi::yy_maths {
+
+template<std::size_t Inputs,
+         std::size_t Outputs,
+         typename T = double>
+class ekf_fixed final
+{
+  public:
+    static_assert((Inputs > 0) && (Outputs > 0), "ekf_fixed dimensions must be non-zero");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    static constexpr value_type EPS = value_type{1e-4};
+    static constexpr size_type m = Inputs;  // Number of inputs
+    static constexpr size_type n = Outputs; // Number of outputs
+
+    using vector_m = yy_maths::c_vector<value_type, m>;
+    using vector_n = yy_maths::c_vector<value_type, n>;
+    using matrix_mm = yy_maths::c_matrix<value_type, m, m>;
+    using matrix_mn = yy_maths::c_matrix<value_type, m, n>;
+    using matrix_nn = yy_maths::c_matrix<value_type, n, n>;
+
+    ekf_fixed() noexcept
+    {
+      reset();
+
+      for(size_type i = 0; i < m; ++i)
+      {
+        m_R(i) = EPS;
+      }
+    }
+
+    explicit ekf_fixed(const vector_m & p_r) noexcept
+    {
+      reset();
+
+      for(size_type i = 0; i < m; ++i)
+      {
+        m_R(i) = p_r(i);
+      }
+    }
+
+    ekf_fixed(const ekf_fixed & other) noexcept = default;
+    ekf_fixed(ekf_fixed && other) noexcept = default;
+
+    ekf_fixed & operator=(const ekf_fixed & other) noexcept = default;
+    ekf_fixed & operator=(ekf_fixed && other) noexcept = default;
+
+    void predict() noexcept
+    {
+      // P_k = F P_{k-1} F^T + Q, with F == I and Q == EPS I.
+      for(size_type i = 0; i < n; ++i)
+      {
+        m_P(i, i) += EPS;
+      }
+    }
+
+    bool update(const vector_m & p_z, // observations m wide
+                const matrix_mn & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector_m & p_hx) noexcept // m wide
+    {
+      // HP = H P
+      matrix_mn HP;
+      for(size_type i = 0; i < m; ++i)
+      {
+        for(size_type j = 0; j < n; ++j)
+        {
+          value_type sum{};
+          for(size_type k = 0; k < n; ++k)
+          {
+            sum += p_h(i, k) * m_P(k, j);
+          }
+          HP(i, j) = sum;
+        }
+      }
+
+      // S = H P H^T + R, upper triangle only.
+      matrix_mm S;
+      for(size_type i = 0; i < m; ++i)
+      {
+        for(size_type j = i; j < m; ++j)
+        {
+          value_type sum{};
+          for(size_type k = 0; k < n; ++k)
+          {
+            sum += HP(i, k) * p_h(j, k);
+          }
+          S(i, j) = sum;
+        }
+        S(i, i) += m_R(i);
+      }
+
+      // S = L L^T in place.
+      vector_m L_diag;
+      if(!cholesky_factor(S, L_diag))
+      {
+        return false;
+      }
+
+      // W = S^{-1} H P, so G = P H^T S^{-1} = W^T as P is symmetric.
+      matrix_mn W{HP};
+      cholesky_solve(S, L_diag, W);
+
+      // \hat{x}_k = \hat{x_k} + G_k(z_k - h(\hat{x}_k))
+      vector_m z_hx;
+      for(size_type i = 0; i < m; ++i)
+      {
+        z_hx(i) = p_z(i) - p_hx(i);
+      }
+
+      for(size_type j = 0; j < n; ++j)
+      {
+        value_type sum{};
+        for(size_type k = 0; k < m; ++k)
+        {
+          sum += W(k, j) * z_hx(k);
+        }
+        m_x(j) += sum;
+      }
+
+      // P_k = (I - G_k H_k) P_k = P_k - (H P)^T W
+      for(size_type i = 0; i < n; ++i)
+      {
+        for(size_type j = i; j < n; ++j)
+        {
+          value_type sum{};
+          for(size_type k = 0; k < m; ++k)
+          {
+            sum += HP(k, i) * W(k, j);
+          }
+          m_P(i, j) -= sum;
+          m_P(j, i) = m_P(i, j);
+        }
+      }
+
+      return true;
+    }
+
+    const vector_n & X() const noexcept
+    {
+      return m_x;
+    }
+
+    const value_type & X(size_type idx) const noexcept
+    {
+      return m_x(idx);
+    }
+
+    static constexpr size_type N() noexcept
+    {
+      return n;
+    }
+
+    static constexpr size_type M() noexcept
+    {
+      return m;
+    }
+
+  private:
+    void reset() noexcept
+    {
+      for(size_type i = 0; i < n; ++i)
+      {
+        m_x(i) = value_type{};
+        for(size_type j = 0; j < n; ++j)
+        {
+          m_P(i, j) = (i == j) ? value_type{1} : value_type{};
+        }
+      }
+    }
+
+    vector_n m_x;  // State vector.
+    matrix_nn m_P; // Prediction error covariance
+    vector_m m_R;  // Measurement noise (diagonal).
+};
+
+} // namespace yafiyogi::yy_maths
@@ -0,0 +1,226 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "yy_matrix_util.hpp"
+
+#include "yy_ekf_group.hpp"
+
+namespace yafiyogi::yy_maths {
+
+ekf_group::ekf_group(size_type p_m,
+                     size_type p_n,
+                     size_type p_members) noexcept:
+  m_n(p_n),
+  m_m(p_m),
+  m_members(p_members),
+  m_x(zero_matrix{m_n, m_members}),
+  m_P(identity_matrix{m_n}),
+  m_R(vector{m_m, EPS}),
+  m_FP(m_n, m_n),
+  m_FX(m_n, m_members),
+  m_HP(m_m, m_n),
+  m_S(m_m, m_m),
+  m_W(m_m, m_n),
+  m_chol(m_m),
+  m_G(m_n, m_m),
+  m_GHP(m_n, m_n),
+  m_z_hx(m_m, m_members)
+{
+}
+
+ekf_group::ekf_group(size_type p_m,
+                     size_type p_n,
+                     size_type p_members,
+                     const vector & p_r) noexcept:
+  ekf_group(p_m, p_n, p_members)
+{
+  vector diagonal_vec{m_m, EPS};
+
+  const size_type size = std::min(m_m, p_r.size());
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    diagonal_vec(i) = p_r(i);
+  }
+
+  diagonal_matrix tmp{diagonal_vec};
+  m_R.swap(tmp);
+}
+
+ekf_group::ekf_group(size_type p_m,
+                     size_type p_n,
+                     size_type p_members,
+                     const vector & p_r,
+                     process_model p_model) noexcept:
+  ekf_group(p_m, p_n, p_members, p_r)
+{
+  m_model = std::move(p_model);
+}
+
+ekf_group::ekf_group(ekf_group && other) noexcept:
+  m_n(other.m_n),
+  m_m(other.m_m),
+  m_members(other.m_members),
+  m_x(),
+  m_P(),
+  m_R(),
+  m_model(std::move(other.m_model)),
+  m_pending(other.m_pending),
+  m_FP(),
+  m_FX(),
+  m_HP(),
+  m_S(),
+  m_W(),
+  m_chol(),
+  m_G(),
+  m_GHP(),
+  m_z_hx()
+{
+  other.m_n = 0;
+  other.m_m = 0;
+  other.m_members = 0;
+  other.m_pending = 0;
+
+  m_x.swap(other.m_x);
+  m_P.swap(other.m_P);
+  m_R.swap(other.m_R);
+  m_FP.swap(other.m_FP);
+  m_FX.swap(other.m_FX);
+  m_HP.swap(other.m_HP);
+  m_S.swap(other.m_S);
+  m_W.swap(other.m_W);
+  m_chol.swap(other.m_chol);
+  m_G.swap(other.m_G);
+  m_GHP.swap(other.m_GHP);
+  m_z_hx.swap(other.m_z_hx);
+}
+
+ekf_group & ekf_group::operator=(ekf_group && other) noexcept
+{
+  if(this != &other)
+  {
+    m_n = other.m_n;
+    other.m_n = 0;
+    m_m = other.m_m;
+    other.m_m = 0;
+    m_members = other.m_members;
+    other.m_members = 0;
+    m_pending = other.m_pending;
+    other.m_pending = 0;
+
+    m_x = matrix{};
+    m_x.swap(other.m_x);
+    m_P = matrix{};
+    m_P.swap(other.m_P);
+    m_R = diagonal_matrix_type{};
+    m_R.swap(other.m_R);
+    m_model = std::move(other.m_model);
+    m_FP = matrix{};
+    m_FP.swap(other.m_FP);
+    m_FX = matrix{};
+    m_FX.swap(other.m_FX);
+    m_HP = matrix{};
+    m_HP.swap(other.m_HP);
+    m_S = matrix{};
+    m_S.swap(other.m_S);
+    m_W = matrix{};
+    m_W.swap(other.m_W);
+    m_chol = vector{};
+    m_chol.swap(other.m_chol);
+    m_G = matrix{};
+    m_G.swap(other.m_G);
+    m_GHP = matrix{};
+    m_GHP.swap(other.m_GHP);
+    m_z_hx = matrix{};
+    m_z_hx.swap(other.m_z_hx);
+  }
+  return *this;
+}
+
+void ekf_group::predict(size_type p_steps) noexcept
+{
+  std::visit([this, p_steps](const auto & model) {
+    model.predict_states(m_x, p_steps, m_FX);
+  }, m_model);
+
+  m_pending += p_steps;
+}
+
+void ekf_group::apply_pending_predicts() noexcept
+{
+  if(0 == m_pending)
+  {
+    return;
+  }
+
+  std::visit([this](const auto & model) {
+    model.predict_covariance(m_P, m_pending, m_FP);
+  }, m_model);
+
+  m_pending = 0;
+}
+
+bool ekf_group::update(const matrix & p_z, // m x members
+                       const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                       const matrix & p_hx) noexcept // m x members
+{
+  namespace bnu = boost::numeric::ublas;
+
+  apply_pending_predicts();
+
+  // Shared track, once for the whole group:
+  // G_k = P_k H^T_k (H_k P_k H^T_k + R)^{-1} = (H P)^T S^{-1}
+  multiply(p_h, m_P, m_HP);
+
+  bnu::noalias(m_S) = m_R; // Add R measurement noise.
+  multiply(m_HP, bnu::trans(p_h), m_S, false);
+
+  // Factor S in place and solve S W = H P rather than inverting S.
+  if(!cholesky_factor(m_S, m_S, m_chol))
+  {
+    return false;
+  }
+
+  bnu::noalias(m_W) = m_HP;
+  cholesky_solve(m_S, m_chol, m_W);
+
+  // G_k = W^T as P & S are symmetric.
+  bnu::noalias(m_G) = bnu::trans(m_W);
+
+  // P_k = (I - G_k H_k) P_k = P_k - G_k (H P)
+  multiply(m_G, m_HP, m_GHP);
+  bnu::noalias(m_P) -= m_GHP;
+
+  // Per member: \hat{x}_k = \hat{x_k} + G_k(z_k - h(\hat{x}_k))
+  bnu::noalias(m_z_hx) = p_z;
+  bnu::noalias(m_z_hx) -= p_hx;
+
+  multiply(m_G, m_z_hx, m_x, false);
+
+  return true;
+}
+
+} // namespace yafiyogi::yy_maths
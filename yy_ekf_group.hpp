@@ -0,0 +1,139 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// A group of filters with identical H, R, process model & initial P.
+// P & G don't depend on the measurements, so every member would carry
+// the same covariance; the group keeps one covariance track, computed once
+// per step, and a state vector per member (a column of X). Memory & work
+// for P & G are shared, the per member cost is only x += G (z - h(x)).
+
+#pragma once
+
+#include <variant>
+
+#include "yy_diagonal_matrix.hpp"
+#include "yy_ekf_process_model.hpp"
+#include "yy_matrix.hpp"
+
+namespace yafiyogi::yy_maths {
+
+class ekf_group final
+{
+  public:
+    using value_type = double;
+    static constexpr value_type EPS = 1e-4;
+
+    using matrix = yy_maths::matrix<value_type>;
+    using identity_matrix = yy_maths::identity_matrix<value_type>;
+    using diagonal_matrix_type = diagonal_matrix<value_type>;
+    using zero_matrix = yy_maths::zero_matrix<value_type>;
+    using vector = yy_maths::vector<value_type>;
+    using size_type = matrix::size_type;
+    using identity_model = identity_process_model<value_type>;
+    using constant_velocity_model = constant_velocity_process_model<value_type>;
+    using dense_model = dense_process_model<value_type>;
+    using process_model = std::variant<identity_model,
+                                       constant_velocity_model,
+                                       dense_model>;
+
+    ekf_group(size_type p_m, size_type p_n, size_type p_members) noexcept;
+    ekf_group(size_type p_m, size_type p_n, size_type p_members,
+              const vector & p_r) noexcept;
+    ekf_group(size_type p_m, size_type p_n, size_type p_members,
+              const vector & p_r, process_model p_model) noexcept;
+
+    constexpr ekf_group() noexcept = default;
+    ekf_group(const ekf_group & other) noexcept = default;
+    ekf_group(ekf_group && other) noexcept;
+
+    ekf_group & operator=(const ekf_group & other) noexcept = default;
+    ekf_group & operator=(ekf_group && other) noexcept;
+
+    // Lazy, as ekf::predict(). Advances every member's state.
+    void predict(size_type p_steps = 1) noexcept;
+
+    // p_z & p_hx are m x members, one column per member, all observed
+    // through the same H.
+    bool update(const matrix & p_z, // m x members
+                const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                const matrix & p_hx) noexcept; // m x members
+
+    // n x members, one state per column.
+    const matrix & X() const noexcept
+    {
+      return m_x;
+    }
+
+    const value_type & X(size_type p_member,
+                         size_type idx) const noexcept
+    {
+      return m_x(idx, p_member);
+    }
+
+    // Shared covariance (pending predicts not applied).
+    const matrix & P() const noexcept
+    {
+      return m_P;
+    }
+
+    constexpr size_type N() const noexcept
+    {
+      return m_n;
+    }
+
+    constexpr size_type M() const noexcept
+    {
+      return m_m;
+    }
+
+    constexpr size_type size() const noexcept
+    {
+      return m_members;
+    }
+
+  private:
+    void apply_pending_predicts() noexcept;
+
+    size_type m_n = 0;          // Number of outputs
+    size_type m_m = 0;          // Number of inputs
+    size_type m_members = 0;    // Number of filters in the group.
+    matrix m_x{};               // n x members, state vectors.
+    matrix m_P{};               // Shared prediction error covariance
+    diagonal_matrix_type m_R{}; // Measurement noise.
+    process_model m_model{identity_model{EPS}}; // Process model Jacobian & noise.
+    size_type m_pending = 0;    // Covariance predictions not yet applied.
+    matrix m_FP{};              // n x n scratch.
+    matrix m_FX{};              // n x members scratch.
+    matrix m_HP{};              // m x n scratch.
+    matrix m_S{};               // m x m scratch, H P H^T + R & its factor.
+    matrix m_W{};               // m x n scratch, S^{-1} H P.
+    vector m_chol{};            // m scratch.
+    matrix m_G{};               // n x m scratch, shared gain.
+    matrix m_GHP{};             // n x n scratch.
+    matrix m_z_hx{};            // m x members scratch.
+};
+
+} // namespace yafiyogi::yy_maths
@@ -0,0 +1,232 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "yy_matrix_util.hpp"
+
+#include "yy_ekf_packed.hpp"
+
+namespace yafiyogi::yy_maths {
+
+ekf_packed::ekf_packed(size_type p_m,
+                       size_type p_n) noexcept:
+  m_n(p_n),
+  m_m(p_m),
+  m_x(zero_vector{m_n}),
+  m_P(identity_matrix{m_n}),
+  m_R(vector{m_m, EPS}),
+  m_HP(m_m, m_n),
+  m_S(m_m, m_m),
+  m_chol(m_m),
+  m_z_hx(m_m)
+{
+}
+
+ekf_packed::ekf_packed(size_type p_m,
+                       size_type p_n,
+                       const vector & p_r) noexcept:
+  ekf_packed(p_m, p_n)
+{
+  vector diagonal_vec{m_m, EPS};
+
+  const size_type size = std::min(m_m, p_r.size());
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    diagonal_vec(i) = p_r(i);
+  }
+
+  diagonal_matrix tmp{diagonal_vec};
+  m_R.swap(tmp);
+}
+
+ekf_packed::ekf_packed(ekf_packed && other) noexcept:
+  m_n(other.m_n),
+  m_m(other.m_m),
+  m_x(),
+  m_P(),
+  m_R(),
+  m_pending(other.m_pending),
+  m_HP(),
+  m_S(),
+  m_chol(),
+  m_z_hx()
+{
+  other.m_n = 0;
+  other.m_m = 0;
+  other.m_pending = 0;
+
+  m_x.swap(other.m_x);
+  m_P.swap(other.m_P);
+  m_R.swap(other.m_R);
+  m_HP.swap(other.m_HP);
+  m_S.swap(other.m_S);
+  m_chol.swap(other.m_chol);
+  m_z_hx.swap(other.m_z_hx);
+}
+
+ekf_packed & ekf_packed::operator=(ekf_packed && other) noexcept
+{
+  if(this != &other)
+  {
+    m_n = other.m_n;
+    other.m_n = 0;
+    m_m = other.m_m;
+    other.m_m = 0;
+    m_pending = other.m_pending;
+    other.m_pending = 0;
+
+    m_x = vector{};
+    m_x.swap(other.m_x);
+    m_P = symmetric_matrix{};
+    m_P.swap(other.m_P);
+    m_R = diagonal_matrix_type{};
+    m_R.swap(other.m_R);
+    m_HP = matrix{};
+    m_HP.swap(other.m_HP);
+    m_S = matrix{};
+    m_S.swap(other.m_S);
+    m_chol = vector{};
+    m_chol.swap(other.m_chol);
+    m_z_hx = vector{};
+    m_z_hx.swap(other.m_z_hx);
+  }
+  return *this;
+}
+
+void ekf_packed::predict(size_type p_steps) noexcept
+{
+  m_pending += p_steps;
+}
+
+void ekf_packed::apply_pending_predicts() noexcept
+{
+  if(0 == m_pending)
+  {
+    return;
+  }
+
+  // P_k = P_0 + k Q
+  const value_type kq = static_cast<value_type>(m_pending) * EPS;
+  for(size_type i = 0; i < m_n; ++i)
+  {
+    m_P(i, i) += kq;
+  }
+
+  m_pending = 0;
+}
+
+bool ekf_packed::update(const vector & p_z, // observations m wide
+                        const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                        const vector & p_hx) noexcept // m wide
+{
+  apply_pending_predicts();
+
+  // HP = H P. Row k of the packed upper triangle holds P(k, k..n-1)
+  // contiguously, so each stored element is read once, standing in for
+  // both P(k, j) & P(j, k).
+  matrix & HP = m_HP;
+  HP.clear();
+  for(size_type k = 0; k < m_n; ++k)
+  {
+    const value_type * P_k = &m_P(k, k);
+    for(size_type i = 0; i < m_m; ++i)
+    {
+      const value_type h_ik = p_h(i, k);
+      value_type sum = h_ik * P_k[0];
+      for(size_type j = k + 1; j < m_n; ++j)
+      {
+        const value_type p_kj = P_k[j - k];
+        HP(i, j) += h_ik * p_kj;
+        sum += p_h(i, j) * p_kj;
+      }
+      HP(i, k) += sum;
+    }
+  }
+
+  // S = H P H^T + R, upper triangle only (SYRK style).
+  matrix & S = m_S;
+  for(size_type i = 0; i < m_m; ++i)
+  {
+    for(size_type j = i; j < m_m; ++j)
+    {
+      value_type sum{};
+      for(size_type k = 0; k < m_n; ++k)
+      {
+        sum += HP(i, k) * p_h(j, k);
+      }
+      S(i, j) = sum;
+    }
+    S(i, i) += m_R(i, i);
+  }
+
+  // S = L L^T, L below the diagonal of S, diagonal in m_chol.
+  vector & L_diag = m_chol;
+  if(!matrix_util_detail::choldc1(S, L_diag))
+  {
+    return false;
+  }
+
+  // Y = L^{-1} H P, v = L^{-1}(z - h(x))
+  vector & v = m_z_hx;
+  for(size_type i = 0; i < m_m; ++i)
+  {
+    v(i) = p_z(i) - p_hx(i);
+  }
+  matrix_util_detail::cholfs(S, L_diag, v);
+  matrix_util_detail::cholfs_rows(S, L_diag, HP, m_m);
+
+  const matrix & Y = HP;
+
+  // G = P H^T S^{-1} = Y^T L^{-1}, so
+  // \hat{x}_k = \hat{x_k} + Y^T v
+  for(size_type j = 0; j < m_n; ++j)
+  {
+    value_type sum{};
+    for(size_type k = 0; k < m_m; ++k)
+    {
+      sum += Y(k, j) * v(k);
+    }
+    m_x(j) += sum;
+  }
+
+  // P_k = P_k - G H P = P_k - Y^T Y, upper triangle only.
+  for(size_type i = 0; i < m_n; ++i)
+  {
+    for(size_type j = i; j < m_n; ++j)
+    {
+      value_type sum{};
+      for(size_type k = 0; k < m_m; ++k)
+      {
+        sum += Y(k, i) * Y(k, j);
+      }
+      m_P(i, j) -= sum;
+    }
+  }
+
+  return true;
+}
+
+} // namespace yafiyogi::yy_maths
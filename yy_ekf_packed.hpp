@@ -0,0 +1,110 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// ekf variant keeping the covariance as a packed upper triangle
+// (symmetric_matrix). Only one triangle is stored & computed, so P takes
+// half the memory, the products do roughly half the work and P stays
+// exactly symmetric. The process model is F == I, Q = EPS I.
+
+#pragma once
+
+#include "yy_diagonal_matrix.hpp"
+#include "yy_matrix.hpp"
+
+namespace yafiyogi::yy_maths {
+
+class ekf_packed final
+{
+  public:
+    using value_type = double;
+    static constexpr value_type EPS = 1e-4;
+
+    using matrix = yy_maths::matrix<value_type>;
+    using symmetric_matrix = yy_maths::symmetric_matrix<value_type>;
+    using identity_matrix = yy_maths::identity_matrix<value_type>;
+    using diagonal_matrix_type = diagonal_matrix<value_type>;
+    using vector = yy_maths::vector<value_type>;
+    using zero_vector = yy_maths::zero_vector<value_type>;
+    using size_type = matrix::size_type;
+
+    ekf_packed(size_type p_m, size_type p_n) noexcept;
+    ekf_packed(size_type p_m, size_type p_n, const vector & p_r) noexcept;
+
+    constexpr ekf_packed() noexcept = default;
+    ekf_packed(const ekf_packed & other) noexcept = default;
+    ekf_packed(ekf_packed && other) noexcept;
+
+    ekf_packed & operator=(const ekf_packed & other) noexcept = default;
+    ekf_packed & operator=(ekf_packed && other) noexcept;
+
+    // Lazy, as ekf::predict().
+    void predict(size_type p_steps = 1) noexcept;
+    bool update(const vector & p_z, // observations m wide
+                const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector & p_hx) noexcept; // m wide
+
+    const vector & X() const noexcept
+    {
+      return m_x;
+    }
+
+    const value_type & X(size_type idx) const noexcept
+    {
+      return m_x(idx);
+    }
+
+    // Covariance (pending predicts not applied).
+    const symmetric_matrix & P() const noexcept
+    {
+      return m_P;
+    }
+
+    constexpr size_type N() const noexcept
+    {
+      return m_n;
+    }
+
+    constexpr size_type M() const noexcept
+    {
+      return m_m;
+    }
+
+  private:
+    void apply_pending_predicts() noexcept;
+
+    size_type m_n = 0;          // Number of outputs
+    size_type m_m = 0;          // Number of inputs
+    vector m_x{};               // State vector.
+    symmetric_matrix m_P{};     // Prediction error covariance (upper).
+    diagonal_matrix_type m_R{}; // Measurement noise.
+    size_type m_pending = 0;    // Covariance predictions not yet applied.
+    matrix m_HP{};              // m x n scratch.
+    matrix m_S{};               // m x m scratch, H P H^T + R.
+    vector m_chol{};            // m scratch.
+    vector m_z_hx{};            // m scratch.
+};
+
+} // namespace yafiyogi::yy_maths
@@ -0,0 +1,281 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Process models for ekf::predict().
+//   x_k = F x_{k-1}
+//   P_k = F P_{k-1} F^T + Q, Q = q I
+// Each model exploits the structure of its F so only the dense model pays
+// for full n x n products. p_steps applies k predictions at once:
+//   x_{k} = F^k x_0
+//   P_{k} = F^k P_0 F^kT + sum_{i=0}^{k-1} F^i Q F^iT
+
+#pragma once
+
+#include <utility>
+
+#include "boost/numeric/ublas/matrix_expression.hpp"
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_util.hpp"
+
+namespace yafiyogi::yy_maths {
+
+// F = I: O(n).
+template<typename T>
+class identity_process_model final
+{
+  public:
+    using value_type = T;
+    using matrix = yy_maths::matrix<value_type>;
+    using vector = yy_maths::vector<value_type>;
+    using size_type = typename matrix::size_type;
+
+    constexpr identity_process_model() noexcept = default;
+    constexpr explicit identity_process_model(value_type p_q) noexcept:
+      m_q(p_q)
+    {
+    }
+
+    constexpr identity_process_model(const identity_process_model & other) noexcept = default;
+    constexpr identity_process_model(identity_process_model && other) noexcept = default;
+
+    constexpr identity_process_model & operator=(const identity_process_model & other) noexcept = default;
+    constexpr identity_process_model & operator=(identity_process_model && other) noexcept = default;
+
+    constexpr void predict_state(vector & /* p_x */,
+                                 size_type /* p_steps */,
+                                 vector & /* p_scratch */) const noexcept
+    {
+    }
+
+    // As predict_state(), for a state per column of p_X.
+    constexpr void predict_states(matrix & /* p_X */,
+                                  size_type /* p_steps */,
+                                  matrix & /* p_scratch */) const noexcept
+    {
+    }
+
+    constexpr void predict_covariance(matrix & p_P,
+                                      size_type p_steps,
+                                      matrix & /* p_scratch */) const noexcept
+    {
+      // P_k = P_0 + k Q
+      const value_type kq = static_cast<value_type>(p_steps) * m_q;
+      const size_type size = p_P.size1();
+      for(size_type i = 0; i < size; ++i)
+      {
+        p_P(i, i) += kq;
+      }
+    }
+
+  private:
+    value_type m_q{};
+};
+
+// State is laid out as (position, velocity) pairs, each pair evolving as
+// F_b = | 1 dt |
+//       | 0  1 |
+// F is block diagonal so each 2x2 block of P only depends on the same block
+// of the previous P: O(n^2). An odd trailing state is treated as constant.
+template<typename T>
+class constant_velocity_process_model final
+{
+  public:
+    using value_type = T;
+    using matrix = yy_maths::matrix<value_type>;
+    using vector = yy_maths::vector<value_type>;
+    using size_type = typename matrix::size_type;
+
+    constexpr constant_velocity_process_model() noexcept = default;
+    constexpr constant_velocity_process_model(value_type p_dt,
+                                              value_type p_q) noexcept:
+      m_dt(p_dt),
+      m_q(p_q)
+    {
+    }
+
+    constexpr constant_velocity_process_model(const constant_velocity_process_model & other) noexcept = default;
+    constexpr constant_velocity_process_model(constant_velocity_process_model && other) noexcept = default;
+
+    constexpr constant_velocity_process_model & operator=(const constant_velocity_process_model & other) noexcept = default;
+    constexpr constant_velocity_process_model & operator=(constant_velocity_process_model && other) noexcept = default;
+
+    constexpr void predict_state(vector & p_x,
+                                 size_type p_steps,
+                                 vector & /* p_scratch */) const noexcept
+    {
+      // F_b^k = | 1 k dt |
+      //         | 0    1 |
+      const value_type dt = static_cast<value_type>(p_steps) * m_dt;
+      const size_type size = p_x.size() & ~size_type{1};
+      for(size_type i = 0; i < size; i += 2)
+      {
+        p_x(i) += dt * p_x(i + 1);
+      }
+    }
+
+    constexpr void predict_states(matrix & p_X,
+                                  size_type p_steps,
+                                  matrix & /* p_scratch */) const noexcept
+    {
+      const value_type dt = static_cast<value_type>(p_steps) * m_dt;
+      const size_type size = p_X.size1() & ~size_type{1};
+      const size_type columns = p_X.size2();
+      for(size_type i = 0; i < size; i += 2)
+      {
+        for(size_type c = 0; c < columns; ++c)
+        {
+          p_X(i, c) += dt * p_X(i + 1, c);
+        }
+      }
+    }
+
+    constexpr void predict_covariance(matrix & p_P,
+                                      size_type p_steps,
+                                      matrix & /* p_scratch */) const noexcept
+    {
+      const value_type k = static_cast<value_type>(p_steps);
+      const value_type dt = k * m_dt;
+      const size_type size = p_P.size1();
+      const size_type pairs = size & ~size_type{1};
+
+      // Rows: P <- F^k P
+      for(size_type i = 0; i < pairs; i += 2)
+      {
+        for(size_type j = 0; j < size; ++j)
+        {
+          p_P(i, j) += dt * p_P(i + 1, j);
+        }
+      }
+
+      // Columns: P <- P F^kT
+      for(size_type i = 0; i < size; ++i)
+      {
+        for(size_type j = 0; j < pairs; j += 2)
+        {
+          p_P(i, j) += dt * p_P(i, j + 1);
+        }
+      }
+
+      // sum_{i=0}^{k-1} F_b^i q I F_b^iT = q | k + dt^2 s2   dt s1 |
+      //                                      | dt s1           k    |
+      // s1 = sum i, s2 = sum i^2.
+      const value_type s1 = (k * (k - value_type{1})) / value_type{2};
+      const value_type s2 = (s1 * (value_type{2} * k - value_type{1})) / value_type{3};
+      const value_type q_pos = m_q * (k + m_dt * m_dt * s2);
+      const value_type q_cross = m_q * m_dt * s1;
+      const value_type q_vel = m_q * k;
+
+      for(size_type i = 0; i < pairs; i += 2)
+      {
+        p_P(i, i) += q_pos;
+        p_P(i, i + 1) += q_cross;
+        p_P(i + 1, i) += q_cross;
+        p_P(i + 1, i + 1) += q_vel;
+      }
+
+      if(pairs != size)
+      {
+        p_P(pairs, pairs) += q_vel;
+      }
+    }
+
+  private:
+    value_type m_dt{};
+    value_type m_q{};
+};
+
+// General dense Jacobian F: O(n^3).
+template<typename T>
+class dense_process_model final
+{
+  public:
+    using value_type = T;
+    using matrix = yy_maths::matrix<value_type>;
+    using vector = yy_maths::vector<value_type>;
+    using size_type = typename matrix::size_type;
+
+    dense_process_model() noexcept = default;
+    dense_process_model(matrix p_F,
+                        value_type p_q) noexcept:
+      m_F(std::move(p_F)),
+      m_q(p_q)
+    {
+    }
+
+    dense_process_model(const dense_process_model & other) noexcept = default;
+    dense_process_model(dense_process_model && other) noexcept = default;
+
+    dense_process_model & operator=(const dense_process_model & other) noexcept = default;
+    dense_process_model & operator=(dense_process_model && other) noexcept = default;
+
+    void predict_state(vector & p_x,
+                       size_type p_steps,
+                       vector & p_scratch) const noexcept
+    {
+      for(size_type step = 0; step < p_steps; ++step)
+      {
+        multiply(m_F, p_x, p_scratch);
+        p_x.swap(p_scratch);
+      }
+    }
+
+    void predict_states(matrix & p_X,
+                        size_type p_steps,
+                        matrix & p_scratch) const noexcept
+    {
+      for(size_type step = 0; step < p_steps; ++step)
+      {
+        multiply(m_F, p_X, p_scratch);
+        p_X.swap(p_scratch);
+      }
+    }
+
+    void predict_covariance(matrix & p_P,
+                            size_type p_steps,
+                            matrix & p_scratch) const noexcept
+    {
+      namespace bnu = boost::numeric::ublas;
+
+      const size_type size = p_P.size1();
+      for(size_type step = 0; step < p_steps; ++step)
+      {
+        multiply(m_F, p_P, p_scratch);
+        multiply(p_scratch, bnu::trans(m_F), p_P);
+
+        for(size_type i = 0; i < size; ++i)
+        {
+          p_P(i, i) += m_q;
+        }
+      }
+    }
+
+  private:
+    matrix m_F{};
+    value_type m_q{};
+};
+
+} // namespace yafiyogi::yy_maths
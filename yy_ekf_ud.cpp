@@ -0,0 +1,277 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Bierman & Thornton algorithms after Grewal & Andrews,
+// "Kalman Filtering: Theory and Practice Using MATLAB", chapter 6.
+
+#include "yy_ekf_ud.hpp"
+
+namespace yafiyogi::yy_maths {
+
+ekf_ud::ekf_ud(size_type p_m,
+               size_type p_n) noexcept:
+  m_n(p_n),
+  m_m(p_m),
+  m_x(zero_vector{m_n}),
+  m_U(identity_matrix{m_n}),
+  m_D(m_n, value_type{1}),
+  m_R(vector{m_m, EPS}),
+  m_W(m_n, 2 * m_n),
+  m_Dw(2 * m_n),
+  m_f(m_n),
+  m_b(m_n),
+  m_dx(m_n)
+{
+}
+
+ekf_ud::ekf_ud(size_type p_m,
+               size_type p_n,
+               const vector & p_r) noexcept:
+  ekf_ud(p_m, p_n)
+{
+  vector diagonal_vec{m_m, EPS};
+
+  const size_type size = std::min(m_m, p_r.size());
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    diagonal_vec(i) = p_r(i);
+  }
+
+  diagonal_matrix tmp{diagonal_vec};
+  m_R.swap(tmp);
+}
+
+ekf_ud::ekf_ud(ekf_ud && other) noexcept:
+  m_n(other.m_n),
+  m_m(other.m_m),
+  m_x(),
+  m_U(),
+  m_D(),
+  m_R(),
+  m_pending(other.m_pending),
+  m_W(),
+  m_Dw(),
+  m_f(),
+  m_b(),
+  m_dx()
+{
+  other.m_n = 0;
+  other.m_m = 0;
+  other.m_pending = 0;
+
+  m_x.swap(other.m_x);
+  m_U.swap(other.m_U);
+  m_D.swap(other.m_D);
+  m_R.swap(other.m_R);
+  m_W.swap(other.m_W);
+  m_Dw.swap(other.m_Dw);
+  m_f.swap(other.m_f);
+  m_b.swap(other.m_b);
+  m_dx.swap(other.m_dx);
+}
+
+ekf_ud & ekf_ud::operator=(ekf_ud && other) noexcept
+{
+  if(this != &other)
+  {
+    m_n = other.m_n;
+    other.m_n = 0;
+    m_m = other.m_m;
+    other.m_m = 0;
+    m_pending = other.m_pending;
+    other.m_pending = 0;
+
+    m_x = vector{};
+    m_x.swap(other.m_x);
+    m_U = matrix{};
+    m_U.swap(other.m_U);
+    m_D = vector{};
+    m_D.swap(other.m_D);
+    m_R = diagonal_matrix_type{};
+    m_R.swap(other.m_R);
+    m_W = matrix{};
+    m_W.swap(other.m_W);
+    m_Dw = vector{};
+    m_Dw.swap(other.m_Dw);
+    m_f = vector{};
+    m_f.swap(other.m_f);
+    m_b = vector{};
+    m_b.swap(other.m_b);
+    m_dx = vector{};
+    m_dx.swap(other.m_dx);
+  }
+  return *this;
+}
+
+void ekf_ud::predict(size_type p_steps) noexcept
+{
+  m_pending += p_steps;
+}
+
+void ekf_ud::apply_pending_predicts() noexcept
+{
+  if(0 == m_pending)
+  {
+    return;
+  }
+
+  // Thornton's modified weighted Gram-Schmidt with F == I & G == I:
+  // P_k = U D U^T + k Q = W diag(D, k Q) W^T, W = [U | I].
+  const value_type kq = static_cast<value_type>(m_pending) * EPS;
+  const size_type columns = 2 * m_n;
+
+  for(size_type i = 0; i < m_n; ++i)
+  {
+    for(size_type k = 0; k < m_n; ++k)
+    {
+      m_W(i, k) = m_U(i, k);
+      m_W(i, m_n + k) = (i == k) ? value_type{1} : value_type{};
+    }
+    m_Dw(i) = m_D(i);
+    m_Dw(m_n + i) = kq;
+  }
+
+  for(size_type j = m_n; j-- > 0;)
+  {
+    value_type sigma{};
+    for(size_type k = 0; k < columns; ++k)
+    {
+      const value_type w_jk = m_W(j, k);
+      sigma += w_jk * w_jk * m_Dw(k);
+    }
+
+    m_D(j) = sigma;
+    m_U(j, j) = value_type{1};
+
+    const value_type inv_sigma = (sigma > value_type{}) ? (value_type{1} / sigma) : value_type{};
+    for(size_type i = 0; i < j; ++i)
+    {
+      value_type s{};
+      for(size_type k = 0; k < columns; ++k)
+      {
+        s += m_W(i, k) * m_Dw(k) * m_W(j, k);
+      }
+
+      const value_type u_ij = s * inv_sigma;
+      m_U(i, j) = u_ij;
+      m_U(j, i) = value_type{};
+
+      for(size_type k = 0; k < columns; ++k)
+      {
+        m_W(i, k) -= u_ij * m_W(j, k);
+      }
+    }
+  }
+
+  m_pending = 0;
+}
+
+bool ekf_ud::update(const vector & p_z, // observations m wide
+                    const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                    const vector & p_hx) noexcept // m wide
+{
+  apply_pending_predicts();
+
+  bool applied_all = true;
+  m_dx.clear();
+
+  for(size_type i = 0; i < m_m; ++i)
+  {
+    // Bierman scalar update for measurement row h_i.
+    // f = U^T h_i^T, b = D f
+    value_type z_hx = p_z(i) - p_hx(i);
+    for(size_type j = 0; j < m_n; ++j)
+    {
+      value_type f_j{};
+      for(size_type k = 0; k <= j; ++k)
+      {
+        f_j += m_U(k, j) * p_h(i, k);
+      }
+      m_f(j) = f_j;
+      m_b(j) = m_D(j) * f_j;
+
+      // Innovation against the state as corrected by earlier measurements.
+      z_hx -= p_h(i, j) * m_dx(j);
+    }
+
+    value_type alpha = m_R(i, i);
+    if(alpha <= value_type{})
+    {
+      applied_all = false;
+      continue;
+    }
+
+    value_type gamma = value_type{1} / alpha;
+    for(size_type j = 0; j < m_n; ++j)
+    {
+      const value_type beta = alpha;
+      alpha += m_f(j) * m_b(j);
+      const value_type lambda = -m_f(j) * gamma;
+      gamma = value_type{1} / alpha;
+      m_D(j) *= beta * gamma;
+
+      for(size_type k = 0; k < j; ++k)
+      {
+        const value_type u_kj = m_U(k, j);
+        m_U(k, j) = u_kj + m_b(k) * lambda;
+        m_b(k) += m_b(j) * u_kj;
+      }
+    }
+
+    // K = b / alpha
+    const value_type scale = z_hx * gamma;
+    for(size_type j = 0; j < m_n; ++j)
+    {
+      m_dx(j) += m_b(j) * scale;
+    }
+  }
+
+  namespace bnu = boost::numeric::ublas;
+
+  bnu::noalias(m_x) += m_dx;
+
+  return applied_all;
+}
+
+void ekf_ud::P(matrix & p_P) const noexcept
+{
+  for(size_type i = 0; i < m_n; ++i)
+  {
+    for(size_type j = i; j < m_n; ++j)
+    {
+      value_type sum{};
+      for(size_type k = j; k < m_n; ++k)
+      {
+        sum += m_U(i, k) * m_D(k) * m_U(j, k);
+      }
+      p_P(i, j) = sum;
+      p_P(j, i) = sum;
+    }
+  }
+}
+
+} // namespace yafiyogi::yy_maths
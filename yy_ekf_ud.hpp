@@ -0,0 +1,119 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// ekf variant propagating the U-D factors of the covariance, P = U D U^T,
+// U unit upper triangular & D diagonal (Bierman/Thornton). The factored
+// form keeps P symmetric & positive semi-definite by construction, and
+// with diagonal R the update is a sequence of scalar Bierman updates,
+// so H P H^T + R is never formed or inverted. The process model is
+// F == I, Q = EPS I.
+
+#pragma once
+
+#include "yy_diagonal_matrix.hpp"
+#include "yy_matrix.hpp"
+
+namespace yafiyogi::yy_maths {
+
+class ekf_ud final
+{
+  public:
+    using value_type = double;
+    static constexpr value_type EPS = 1e-4;
+
+    using matrix = yy_maths::matrix<value_type>;
+    using identity_matrix = yy_maths::identity_matrix<value_type>;
+    using diagonal_matrix_type = diagonal_matrix<value_type>;
+    using vector = yy_maths::vector<value_type>;
+    using zero_vector = yy_maths::zero_vector<value_type>;
+    using size_type = matrix::size_type;
+
+    ekf_ud(size_type p_m, size_type p_n) noexcept;
+    ekf_ud(size_type p_m, size_type p_n, const vector & p_r) noexcept;
+
+    constexpr ekf_ud() noexcept = default;
+    ekf_ud(const ekf_ud & other) noexcept = default;
+    ekf_ud(ekf_ud && other) noexcept;
+
+    ekf_ud & operator=(const ekf_ud & other) noexcept = default;
+    ekf_ud & operator=(ekf_ud && other) noexcept;
+
+    // Lazy, as ekf::predict().
+    void predict(size_type p_steps = 1) noexcept;
+
+    // Returns false if a measurement had to be skipped because its
+    // innovation variance wasn't positive (only possible if R isn't).
+    bool update(const vector & p_z, // observations m wide
+                const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector & p_hx) noexcept; // m wide
+
+    // Reconstruct P = U D U^T.
+    void P(matrix & p_P) const noexcept;
+
+    // Diagonal factor D of P = U D U^T.
+    const vector & D() const noexcept
+    {
+      return m_D;
+    }
+
+    const vector & X() const noexcept
+    {
+      return m_x;
+    }
+
+    const value_type & X(size_type idx) const noexcept
+    {
+      return m_x(idx);
+    }
+
+    constexpr size_type N() const noexcept
+    {
+      return m_n;
+    }
+
+    constexpr size_type M() const noexcept
+    {
+      return m_m;
+    }
+
+  private:
+    void apply_pending_predicts() noexcept;
+
+    size_type m_n = 0;          // Number of outputs
+    size_type m_m = 0;          // Number of inputs
+    vector m_x{};               // State vector.
+    matrix m_U{};               // Unit upper triangular factor of P.
+    vector m_D{};               // Diagonal factor of P.
+    diagonal_matrix_type m_R{}; // Measurement noise.
+    size_type m_pending = 0;    // Covariance predictions not yet applied.
+    matrix m_W{};               // n x 2n scratch, Thornton's [U | I].
+    vector m_Dw{};              // 2n scratch, Thornton's diag(D, Q).
+    vector m_f{};               // n scratch, U^T h^T.
+    vector m_b{};               // n scratch, gain.
+    vector m_dx{};              // n scratch, accumulated state correction.
+};
+
+} // namespace yafiyogi::yy_maths
@@ -0,0 +1,376 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Saturating binary fixed point scalar, Rep holding the value scaled by
+// 2^Frac: q16_16 (32 bit) & q32_32 (64 bit). Every operation is integer
+// arithmetic, so results are bit identical on any platform, and narrower
+// than double so more lanes fit in a vector register. Results outside
+// the representable range clamp to min()/max(), division by zero
+// saturates towards the dividend's sign, and products & quotients round
+// to nearest. abs() & sqrt() are found by ADL, so the Cholesky kernels
+// in yy_matrix_util.hpp (`using std::sqrt; sqrt(x)`) become an integer
+// Cholesky for a fixed_point matrix, and basic_ekf & ekf_fixed can run on
+// it unchanged.
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace yafiyogi::yy_maths {
+namespace fixed_point_detail {
+
+template<typename Rep>
+struct wide;
+
+template<>
+struct wide<std::int32_t>
+{
+    using type = std::int64_t;
+    using unsigned_type = std::uint64_t;
+};
+
+template<>
+struct wide<std::int64_t>
+{
+    __extension__ using type = __int128;
+    __extension__ using unsigned_type = unsigned __int128;
+};
+
+template<typename Rep>
+using wide_t = typename wide<Rep>::type;
+
+template<typename Rep>
+using unsigned_wide_t = typename wide<Rep>::unsigned_type;
+
+// floor(sqrt(p_value)), bit by bit.
+template<typename U>
+constexpr U isqrt(U p_value) noexcept
+{
+  U root = 0;
+  U bit = U{1} << (sizeof(U) * 8 - 2);
+
+  while(bit > p_value)
+  {
+    bit >>= 2;
+  }
+
+  while(0 != bit)
+  {
+    if(p_value >= root + bit)
+    {
+      p_value -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return root;
+}
+
+} // namespace fixed_point_detail
+
+template<typename Rep,
+         int Frac>
+class fixed_point final
+{
+  public:
+    static_assert(std::is_same_v<Rep, std::int32_t> || std::is_same_v<Rep, std::int64_t>,
+                  "fixed_point needs a 32 or 64 bit signed representation");
+    static_assert((Frac > 0) && (Frac < static_cast<int>(sizeof(Rep) * 8) - 1),
+                  "fixed_point fraction bits out of range");
+
+    using rep_type = Rep;
+    using wide_type = fixed_point_detail::wide_t<rep_type>;
+    using unsigned_wide_type = fixed_point_detail::unsigned_wide_t<rep_type>;
+    static constexpr int fraction_bits = Frac;
+    static constexpr rep_type one_raw = rep_type{1} << Frac;
+
+    constexpr fixed_point() noexcept = default;
+
+    // From an integer or floating point value, saturating.
+    template<typename V>
+    constexpr explicit fixed_point(V p_value) noexcept:
+      m_raw(from_value(p_value))
+    {
+    }
+
+    constexpr fixed_point(const fixed_point & other) noexcept = default;
+    constexpr fixed_point(fixed_point && other) noexcept = default;
+
+    constexpr fixed_point & operator=(const fixed_point & other) noexcept = default;
+    constexpr fixed_point & operator=(fixed_point && other) noexcept = default;
+
+    static constexpr fixed_point from_raw(rep_type p_raw) noexcept
+    {
+      fixed_point value;
+      value.m_raw = p_raw;
+
+      return value;
+    }
+
+    static constexpr fixed_point min() noexcept
+    {
+      return from_raw(std::numeric_limits<rep_type>::min());
+    }
+
+    static constexpr fixed_point max() noexcept
+    {
+      return from_raw(std::numeric_limits<rep_type>::max());
+    }
+
+    // Smallest positive value.
+    static constexpr fixed_point epsilon() noexcept
+    {
+      return from_raw(1);
+    }
+
+    constexpr rep_type raw() const noexcept
+    {
+      return m_raw;
+    }
+
+    template<typename V>
+    constexpr explicit operator V() const noexcept
+    {
+      if constexpr(std::is_floating_point_v<V>)
+      {
+        return static_cast<V>(m_raw) / static_cast<V>(one_raw);
+      }
+      else
+      {
+        // Truncates towards zero, as a float to integer conversion does.
+        return static_cast<V>(m_raw / one_raw);
+      }
+    }
+
+    constexpr fixed_point operator-() const noexcept
+    {
+      return from_raw(saturate(-static_cast<wide_type>(m_raw)));
+    }
+
+    constexpr fixed_point operator+() const noexcept
+    {
+      return *this;
+    }
+
+    constexpr fixed_point & operator+=(fixed_point p_other) noexcept
+    {
+      m_raw = saturate(static_cast<wide_type>(m_raw) + p_other.m_raw);
+      return *this;
+    }
+
+    constexpr fixed_point & operator-=(fixed_point p_other) noexcept
+    {
+      m_raw = saturate(static_cast<wide_type>(m_raw) - p_other.m_raw);
+      return *this;
+    }
+
+    constexpr fixed_point & operator*=(fixed_point p_other) noexcept
+    {
+      // Round half up.
+      const wide_type product = static_cast<wide_type>(m_raw) * p_other.m_raw;
+      m_raw = saturate((product + (wide_type{1} << (Frac - 1))) >> Frac);
+      return *this;
+    }
+
+    constexpr fixed_point & operator/=(fixed_point p_other) noexcept
+    {
+      if(0 == p_other.m_raw)
+      {
+        m_raw = (m_raw > 0) ? max().m_raw : ((m_raw < 0) ? min().m_raw : 0);
+        return *this;
+      }
+
+      // Round half away from zero: move the numerator away from zero by
+      // half the divisor, then truncate.
+      // Widen before negating, so a min() divisor doesn't overflow.
+      wide_type numerator = static_cast<wide_type>(m_raw) * one_raw;
+      const wide_type divisor = p_other.m_raw;
+      const wide_type half = (divisor < 0 ? -divisor : divisor) / 2;
+      numerator += (numerator < 0) ? -half : half;
+      m_raw = saturate(numerator / divisor);
+      return *this;
+    }
+
+    friend constexpr fixed_point operator+(fixed_point p_a,
+                                           fixed_point p_b) noexcept
+    {
+      return p_a += p_b;
+    }
+
+    friend constexpr fixed_point operator-(fixed_point p_a,
+                                           fixed_point p_b) noexcept
+    {
+      return p_a -= p_b;
+    }
+
+    friend constexpr fixed_point operator*(fixed_point p_a,
+                                           fixed_point p_b) noexcept
+    {
+      return p_a *= p_b;
+    }
+
+    friend constexpr fixed_point operator/(fixed_point p_a,
+                                           fixed_point p_b) noexcept
+    {
+      return p_a /= p_b;
+    }
+
+    friend constexpr bool operator==(fixed_point p_a,
+                                     fixed_point p_b) noexcept = default;
+
+    friend constexpr auto operator<=>(fixed_point p_a,
+                                      fixed_point p_b) noexcept = default;
+
+    friend constexpr fixed_point abs(fixed_point p_value) noexcept
+    {
+      return (p_value.m_raw < 0) ? -p_value : p_value;
+    }
+
+    // Negative values give 0.
+    friend constexpr fixed_point sqrt(fixed_point p_value) noexcept
+    {
+      if(p_value.m_raw <= 0)
+      {
+        return fixed_point{};
+      }
+
+      // sqrt(r / 2^F) 2^F = sqrt(r 2^F)
+      const unsigned_wide_type scaled = static_cast<unsigned_wide_type>(p_value.m_raw) << Frac;
+
+      return from_raw(static_cast<rep_type>(fixed_point_detail::isqrt(scaled)));
+    }
+
+    // Public so fixed_point is a structural type, usable as a template
+    // argument (e.g. diagonal_matrix_fixed). Use raw()/from_raw().
+    rep_type m_raw = 0;
+
+  private:
+    static constexpr rep_type saturate(wide_type p_value) noexcept
+    {
+      if(p_value > std::numeric_limits<rep_type>::max())
+      {
+        return std::numeric_limits<rep_type>::max();
+      }
+
+      if(p_value < std::numeric_limits<rep_type>::min())
+      {
+        return std::numeric_limits<rep_type>::min();
+      }
+
+      return static_cast<rep_type>(p_value);
+    }
+
+    template<typename V>
+    static constexpr rep_type from_value(V p_value) noexcept
+    {
+      static_assert(std::is_arithmetic_v<V>, "fixed_point needs an arithmetic value");
+
+      if constexpr(std::is_floating_point_v<V>)
+      {
+        // Not-a-number to 0.
+        const long double scaled = static_cast<long double>(p_value) * static_cast<long double>(one_raw);
+        if(!(scaled == scaled))
+        {
+          return 0;
+        }
+
+        if(scaled >= static_cast<long double>(std::numeric_limits<rep_type>::max()))
+        {
+          return std::numeric_limits<rep_type>::max();
+        }
+
+        if(scaled <= static_cast<long double>(std::numeric_limits<rep_type>::min()))
+        {
+          return std::numeric_limits<rep_type>::min();
+        }
+
+        // Round half away from zero.
+        return static_cast<rep_type>(scaled < 0 ? scaled - 0.5L : scaled + 0.5L);
+      }
+      else if constexpr(std::is_signed_v<V>)
+      {
+        return saturate(static_cast<wide_type>(p_value) * one_raw);
+      }
+      else
+      {
+        const auto max_whole = static_cast<unsigned_wide_type>(std::numeric_limits<rep_type>::max() >> Frac);
+
+        return (static_cast<unsigned_wide_type>(p_value) > max_whole)
+          ? std::numeric_limits<rep_type>::max()
+          : static_cast<rep_type>(static_cast<wide_type>(p_value) * one_raw);
+      }
+    }
+};
+
+using q16_16 = fixed_point<std::int32_t, 16>;
+using q32_32 = fixed_point<std::int64_t, 32>;
+
+} // namespace yafiyogi::yy_maths
+
+template<typename Rep,
+         int Frac>
+class std::numeric_limits<yafiyogi::yy_maths::fixed_point<Rep, Frac>>
+{
+  private:
+    using type = yafiyogi::yy_maths::fixed_point<Rep, Frac>;
+
+  public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = true;
+    static constexpr bool is_bounded = true;
+    static constexpr int radix = 2;
+    static constexpr int digits = std::numeric_limits<Rep>::digits;
+
+    static constexpr type min() noexcept
+    {
+      return type::epsilon();
+    }
+
+    static constexpr type lowest() noexcept
+    {
+      return type::min();
+    }
+
+    static constexpr type max() noexcept
+    {
+      return type::max();
+    }
+
+    static constexpr type epsilon() noexcept
+    {
+      return type::epsilon();
+    }
+};
@@ -0,0 +1,243 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "yy_matrix_util.hpp"
+
+#include "yy_information_filter.hpp"
+
+namespace yafiyogi::yy_maths {
+
+information_filter::contribution::contribution(size_type p_n) noexcept:
+  m_I(zero_matrix{p_n, p_n}),
+  m_i(zero_vector{p_n})
+{
+}
+
+void information_filter::contribution::clear() noexcept
+{
+  m_I.clear();
+  m_i.clear();
+}
+
+void information_filter::contribution::add(const vector & p_z, // observations m wide
+                                           const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                                           const vector & p_hx, // m wide
+                                           const vector & p_r) noexcept // m wide
+{
+  const size_type m = p_h.size1();
+  const size_type n = m_I.size1();
+
+  for(size_type r = 0; r < m; ++r)
+  {
+    // Row r of H, weighted by r_r^{-1}.
+    const value_type r_inv = value_type{1} / p_r(r);
+    const value_type w_z_hx = r_inv * (p_z(r) - p_hx(r));
+
+    for(size_type a = 0; a < n; ++a)
+    {
+      const value_type h_ra = p_h(r, a);
+      if(value_type{} == h_ra)
+      {
+        continue;
+      }
+
+      m_i(a) += h_ra * w_z_hx;
+
+      const value_type w_h_ra = r_inv * h_ra;
+      for(size_type b = 0; b < n; ++b)
+      {
+        m_I(a, b) += w_h_ra * p_h(r, b);
+      }
+    }
+  }
+}
+
+information_filter::contribution & information_filter::contribution::operator+=(const contribution & other) noexcept
+{
+  namespace bnu = boost::numeric::ublas;
+
+  bnu::noalias(m_I) += other.m_I;
+  bnu::noalias(m_i) += other.m_i;
+
+  return *this;
+}
+
+information_filter::information_filter(size_type p_m,
+                                       size_type p_n) noexcept:
+  m_n(p_n),
+  m_m(p_m),
+  m_x(zero_vector{m_n}),
+  m_P(identity_matrix{m_n}),
+  m_R(m_m, EPS),
+  m_info(m_n),
+  m_Y(m_n, m_n),
+  m_FP(m_n, m_n),
+  m_Fx(m_n),
+  m_chol(m_n)
+{
+}
+
+information_filter::information_filter(size_type p_m,
+                                       size_type p_n,
+                                       const vector & p_r) noexcept:
+  information_filter(p_m, p_n)
+{
+  const size_type size = std::min(m_m, p_r.size());
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    m_R(i) = p_r(i);
+  }
+}
+
+information_filter::information_filter(size_type p_m,
+                                       size_type p_n,
+                                       const vector & p_r,
+                                       process_model p_model) noexcept:
+  information_filter(p_m, p_n, p_r)
+{
+  m_model = std::move(p_model);
+}
+
+information_filter::information_filter(information_filter && other) noexcept:
+  m_n(other.m_n),
+  m_m(other.m_m),
+  m_x(),
+  m_P(),
+  m_R(),
+  m_model(std::move(other.m_model)),
+  m_pending(other.m_pending),
+  m_info(std::move(other.m_info)),
+  m_Y(),
+  m_FP(),
+  m_Fx(),
+  m_chol()
+{
+  other.m_n = 0;
+  other.m_m = 0;
+  other.m_pending = 0;
+
+  m_x.swap(other.m_x);
+  m_P.swap(other.m_P);
+  m_R.swap(other.m_R);
+  m_Y.swap(other.m_Y);
+  m_FP.swap(other.m_FP);
+  m_Fx.swap(other.m_Fx);
+  m_chol.swap(other.m_chol);
+}
+
+information_filter & information_filter::operator=(information_filter && other) noexcept
+{
+  if(this != &other)
+  {
+    m_n = other.m_n;
+    other.m_n = 0;
+    m_m = other.m_m;
+    other.m_m = 0;
+    m_pending = other.m_pending;
+    other.m_pending = 0;
+
+    m_x = vector{};
+    m_x.swap(other.m_x);
+    m_P = matrix{};
+    m_P.swap(other.m_P);
+    m_R = vector{};
+    m_R.swap(other.m_R);
+    m_model = std::move(other.m_model);
+    m_info = std::move(other.m_info);
+    m_Y = matrix{};
+    m_Y.swap(other.m_Y);
+    m_FP = matrix{};
+    m_FP.swap(other.m_FP);
+    m_Fx = vector{};
+    m_Fx.swap(other.m_Fx);
+    m_chol = vector{};
+    m_chol.swap(other.m_chol);
+  }
+  return *this;
+}
+
+void information_filter::predict(size_type p_steps) noexcept
+{
+  std::visit([this, p_steps](const auto & model) {
+    model.predict_state(m_x, p_steps, m_Fx);
+  }, m_model);
+
+  m_pending += p_steps;
+}
+
+void information_filter::apply_pending_predicts() noexcept
+{
+  if(0 == m_pending)
+  {
+    return;
+  }
+
+  std::visit([this](const auto & model) {
+    model.predict_covariance(m_P, m_pending, m_FP);
+  }, m_model);
+
+  m_pending = 0;
+}
+
+bool information_filter::update(const vector & p_z, // observations m wide
+                                const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                                const vector & p_hx) noexcept // m wide
+{
+  m_info.clear();
+  m_info.add(p_z, p_h, p_hx, m_R);
+
+  return update(m_info);
+}
+
+bool information_filter::update(const contribution & p_info) noexcept
+{
+  namespace bnu = boost::numeric::ublas;
+
+  apply_pending_predicts();
+
+  // Y = P_k^{-1} + H^T R^{-1} H
+  if(!invert(m_P, m_Y, m_chol))
+  {
+    return false;
+  }
+  bnu::noalias(m_Y) += p_info.I();
+
+  // P_k = Y^{-1}, inverted in the scratch & only swapped in on success
+  // so a failure leaves P as it was.
+  if(!invert_in_place(m_Y, m_chol))
+  {
+    return false;
+  }
+  m_P.swap(m_Y);
+
+  // \hat{x}_k = \hat{x_k} + P_k H^T R^{-1} (z_k - h(\hat{x}_k))
+  multiply(m_P, p_info.i(), m_x, false);
+
+  return true;
+}
+
+} // namespace yafiyogi::yy_maths
@@ -0,0 +1,165 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Information form of ekf for fusing many sensors into a small state
+// (m >> n). Each measurement contributes
+//   I += H^T R^{-1} H
+//   i += H^T R^{-1} (z - h(x))
+// which, with R diagonal, needs no inversion. The update is then
+//   P_k = (P_k^{-1} + I)^{-1}
+//   \hat{x}_k = \hat{x_k} + P_k i
+// so only n x n matrices are ever inverted, whatever m is.
+// Contributions are additive: sensors (or threads) can each fill their
+// own & merge them with += before a single update().
+
+#pragma once
+
+#include <variant>
+
+#include "yy_diagonal_matrix.hpp"
+#include "yy_ekf_process_model.hpp"
+#include "yy_matrix.hpp"
+
+namespace yafiyogi::yy_maths {
+
+class information_filter final
+{
+  public:
+    using value_type = double;
+    static constexpr value_type EPS = 1e-4;
+
+    using matrix = yy_maths::matrix<value_type>;
+    using identity_matrix = yy_maths::identity_matrix<value_type>;
+    using diagonal_matrix_type = diagonal_matrix<value_type>;
+    using zero_matrix = yy_maths::zero_matrix<value_type>;
+    using vector = yy_maths::vector<value_type>;
+    using zero_vector = yy_maths::zero_vector<value_type>;
+    using size_type = matrix::size_type;
+    using identity_model = identity_process_model<value_type>;
+    using constant_velocity_model = constant_velocity_process_model<value_type>;
+    using dense_model = dense_process_model<value_type>;
+    using process_model = std::variant<identity_model,
+                                       constant_velocity_model,
+                                       dense_model>;
+
+    // Sum of measurement information for one update.
+    class contribution final
+    {
+      public:
+        constexpr contribution() noexcept = default;
+        explicit contribution(size_type p_n) noexcept;
+        contribution(const contribution & other) noexcept = default;
+        contribution(contribution && other) noexcept = default;
+
+        contribution & operator=(const contribution & other) noexcept = default;
+        contribution & operator=(contribution && other) noexcept = default;
+
+        void clear() noexcept;
+
+        // Add measurements z, observed through H with diagonal noise r.
+        void add(const vector & p_z, // observations m wide
+                 const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                 const vector & p_hx, // m wide
+                 const vector & p_r) noexcept; // m wide
+
+        contribution & operator+=(const contribution & other) noexcept;
+
+        const matrix & I() const noexcept
+        {
+          return m_I;
+        }
+
+        const vector & i() const noexcept
+        {
+          return m_i;
+        }
+
+      private:
+        matrix m_I{}; // n x n, H^T R^{-1} H
+        vector m_i{}; // n, H^T R^{-1} (z - h(x))
+    };
+
+    information_filter(size_type p_m, size_type p_n) noexcept;
+    information_filter(size_type p_m, size_type p_n, const vector & p_r) noexcept;
+    information_filter(size_type p_m, size_type p_n, const vector & p_r, process_model p_model) noexcept;
+
+    constexpr information_filter() noexcept = default;
+    information_filter(const information_filter & other) noexcept = default;
+    information_filter(information_filter && other) noexcept;
+
+    information_filter & operator=(const information_filter & other) noexcept = default;
+    information_filter & operator=(information_filter && other) noexcept;
+
+    // Lazy, as ekf::predict().
+    void predict(size_type p_steps = 1) noexcept;
+
+    // As ekf::update(), using this filter's R.
+    bool update(const vector & p_z, // observations m wide
+                const matrix & p_h, // m x n (m -> inputs, n -> outputs)
+                const vector & p_hx) noexcept; // m wide
+
+    // Apply pre-summed measurement information. h(x) must have been
+    // evaluated at the current X().
+    bool update(const contribution & p_info) noexcept;
+
+    const vector & X() const noexcept
+    {
+      return m_x;
+    }
+
+    const value_type & X(size_type idx) const noexcept
+    {
+      return m_x(idx);
+    }
+
+    constexpr size_type N() const noexcept
+    {
+      return m_n;
+    }
+
+    constexpr size_type M() const noexcept
+    {
+      return m_m;
+    }
+
+  private:
+    void apply_pending_predicts() noexcept;
+
+    size_type m_n = 0;          // Number of outputs
+    size_type m_m = 0;          // Number of inputs
+    vector m_x{};               // State vector.
+    matrix m_P{};               // Prediction error covariance
+    vector m_R{};               // Measurement noise (diagonal).
+    process_model m_model{identity_model{EPS}}; // Process model Jacobian & noise.
+    size_type m_pending = 0;    // Covariance predictions not yet applied.
+    contribution m_info{};      // Scratch for update(z, h, hx).
+    matrix m_Y{};               // n x n scratch, P^{-1} + I.
+    matrix m_FP{};              // n x n scratch.
+    vector m_Fx{};              // n scratch.
+    vector m_chol{};            // n scratch.
+};
+
+} // namespace yafiyogi::yy_maths
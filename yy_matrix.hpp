@@ -27,6 +27,7 @@
 #pragma once
 
 #include "boost/numeric/ublas/matrix.hpp"
+#include "boost/numeric/ublas/symmetric.hpp"
 #include "boost/numeric/ublas/vector.hpp"
 
 namespace yafiyogi::yy_maths {
@@ -46,4 +47,14 @@ using vector = boost::numeric::ublas::vector<T>;
 template<typename T>
 using zero_vector = boost::numeric::ublas::zero_vector<T>;
 
+template<typename T, std::size_t N, std::size_t M>
+using c_matrix = boost::numeric::ublas::c_matrix<T, N, M>;
+
+template<typename T, std::size_t N>
+using c_vector = boost::numeric::ublas::c_vector<T, N>;
+
+// Packed storage of the upper triangle.
+template<typename T>
+using symmetric_matrix = boost::numeric::ublas::symmetric_matrix<T, boost::numeric::ublas::upper>;
+
 } // namespace yafiyogi::yy_maths
@@ -0,0 +1,358 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Factor, solve & invert batches of same sized symmetric positive definite
+// matrices. The batch is interleaved: row k of a ublas matrix holds packed
+// lower triangle element k = batch_packed_idx(i, j) of every matrix, one
+// column per matrix, so each inner loop runs across matrices over
+// contiguous memory (one SIMD lane per matrix). A matrix whose pivot
+// isn't positive gets a dummy pivot of 1, carries on with the others &
+// is reported by a set bit in the failure mask.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "yy_matrix.hpp"
+
+namespace yafiyogi::yy_maths {
+
+// Bit f % 64 of word f / 64 set if matrix f failed.
+using batch_mask = std::vector<std::uint64_t>;
+
+// Matrices factored together.
+inline constexpr std::size_t batch_width = 64;
+
+constexpr std::size_t batch_packed_size(std::size_t p_n) noexcept
+{
+  return (p_n * (p_n + 1)) / 2;
+}
+
+// Lower triangle, row by row.
+constexpr std::size_t batch_packed_idx(std::size_t i,
+                                       std::size_t j) noexcept
+{
+  return (i >= j) ? ((i * (i + 1)) / 2 + j) : ((j * (j + 1)) / 2 + i);
+}
+
+namespace matrix_batch_detail {
+
+// Kernels over up to batch_width lanes. p_a(k) returns the lanes of
+// packed element k, p_inv_diag(i) & p_b(i) the lanes of element i.
+
+// A = L L^T in place; 1 / L_ii in p_inv_diag. Returns the failed lanes.
+template<typename Rows,
+         typename Diag>
+constexpr std::uint64_t choldc1(Rows && p_a,
+                                Diag && p_inv_diag,
+                                std::size_t p_n,
+                                std::size_t p_width) noexcept
+{
+  using std::sqrt;
+  using value_type = std::remove_cvref_t<decltype(*p_a(0))>;
+
+  std::array<bool, batch_width> ok;
+  ok.fill(true);
+
+  for(std::size_t j = 0; j < p_n; ++j)
+  {
+    value_type * L_jj = p_a(batch_packed_idx(j, j));
+    for(std::size_t k = 0; k < j; ++k)
+    {
+      const value_type * L_jk = p_a(batch_packed_idx(j, k));
+      for(std::size_t f = 0; f < p_width; ++f)
+      {
+        L_jj[f] -= L_jk[f] * L_jk[f];
+      }
+    }
+
+    value_type * inv_jj = p_inv_diag(j);
+    for(std::size_t f = 0; f < p_width; ++f)
+    {
+      const bool positive = L_jj[f] > value_type{};
+      ok[f] = ok[f] && positive;
+      L_jj[f] = positive ? sqrt(L_jj[f]) : value_type{1};
+      inv_jj[f] = value_type{1} / L_jj[f];
+    }
+
+    for(std::size_t i = j + 1; i < p_n; ++i)
+    {
+      value_type * L_ij = p_a(batch_packed_idx(i, j));
+      for(std::size_t k = 0; k < j; ++k)
+      {
+        const value_type * L_ik = p_a(batch_packed_idx(i, k));
+        const value_type * L_jk = p_a(batch_packed_idx(j, k));
+        for(std::size_t f = 0; f < p_width; ++f)
+        {
+          L_ij[f] -= L_ik[f] * L_jk[f];
+        }
+      }
+
+      for(std::size_t f = 0; f < p_width; ++f)
+      {
+        L_ij[f] *= inv_jj[f];
+      }
+    }
+  }
+
+  std::uint64_t failed = 0;
+  for(std::size_t f = 0; f < p_width; ++f)
+  {
+    failed |= static_cast<std::uint64_t>(!ok[f]) << f;
+  }
+
+  return failed;
+}
+
+// Solve L L^T x = b in place.
+template<typename Rows,
+         typename Diag,
+         typename Vec>
+constexpr void cholsl(Rows && p_l,
+                      Diag && p_inv_diag,
+                      Vec && p_b,
+                      std::size_t p_n,
+                      std::size_t p_width) noexcept
+{
+  using value_type = std::remove_cvref_t<decltype(*p_b(0))>;
+
+  for(std::size_t i = 0; i < p_n; ++i)
+  {
+    value_type * b_i = p_b(i);
+    for(std::size_t k = 0; k < i; ++k)
+    {
+      const value_type * L_ik = p_l(batch_packed_idx(i, k));
+      const value_type * b_k = p_b(k);
+      for(std::size_t f = 0; f < p_width; ++f)
+      {
+        b_i[f] -= L_ik[f] * b_k[f];
+      }
+    }
+
+    const value_type * inv_ii = p_inv_diag(i);
+    for(std::size_t f = 0; f < p_width; ++f)
+    {
+      b_i[f] *= inv_ii[f];
+    }
+  }
+
+  for(std::size_t i = p_n; i-- > 0;)
+  {
+    value_type * b_i = p_b(i);
+    for(std::size_t k = i + 1; k < p_n; ++k)
+    {
+      const value_type * L_ki = p_l(batch_packed_idx(k, i));
+      const value_type * b_k = p_b(k);
+      for(std::size_t f = 0; f < p_width; ++f)
+      {
+        b_i[f] -= L_ki[f] * b_k[f];
+      }
+    }
+
+    const value_type * inv_ii = p_inv_diag(i);
+    for(std::size_t f = 0; f < p_width; ++f)
+    {
+      b_i[f] *= inv_ii[f];
+    }
+  }
+}
+
+// Factor left by choldc1() to A^{-1}, in place.
+template<typename Rows,
+         typename Diag>
+constexpr void cholinv(Rows && p_a,
+                       Diag && p_inv_diag,
+                       std::size_t p_n,
+                       std::size_t p_width) noexcept
+{
+  using value_type = std::remove_cvref_t<decltype(*p_a(0))>;
+
+  std::array<value_type, batch_width> sum;
+
+  // W = L^{-1}, column by column.
+  for(std::size_t i = 0; i < p_n; ++i)
+  {
+    const value_type * inv_ii = p_inv_diag(i);
+    value_type * W_ii = p_a(batch_packed_idx(i, i));
+    for(std::size_t f = 0; f < p_width; ++f)
+    {
+      W_ii[f] = inv_ii[f];
+    }
+
+    for(std::size_t j = i + 1; j < p_n; ++j)
+    {
+      sum.fill(value_type{});
+      for(std::size_t k = i; k < j; ++k)
+      {
+        const value_type * L_jk = p_a(batch_packed_idx(j, k));
+        const value_type * W_ki = p_a(batch_packed_idx(k, i));
+        for(std::size_t f = 0; f < p_width; ++f)
+        {
+          sum[f] -= L_jk[f] * W_ki[f];
+        }
+      }
+
+      value_type * W_ji = p_a(batch_packed_idx(j, i));
+      const value_type * inv_jj = p_inv_diag(j);
+      for(std::size_t f = 0; f < p_width; ++f)
+      {
+        W_ji[f] = sum[f] * inv_jj[f];
+      }
+    }
+  }
+
+  // A^{-1}(i, j) = sum_{k>=i} W(k, i) W(k, j). Row i only needs W from
+  // rows >= i & its own diagonal, written last.
+  for(std::size_t i = 0; i < p_n; ++i)
+  {
+    for(std::size_t j = 0; j <= i; ++j)
+    {
+      sum.fill(value_type{});
+      for(std::size_t k = i; k < p_n; ++k)
+      {
+        const value_type * W_ki = p_a(batch_packed_idx(k, i));
+        const value_type * W_kj = p_a(batch_packed_idx(k, j));
+        for(std::size_t f = 0; f < p_width; ++f)
+        {
+          sum[f] += W_ki[f] * W_kj[f];
+        }
+      }
+
+      value_type * a_ij = p_a(batch_packed_idx(i, j));
+      for(std::size_t f = 0; f < p_width; ++f)
+      {
+        a_ij[f] = sum[f];
+      }
+    }
+  }
+}
+
+template<typename T>
+constexpr auto lanes(matrix<T> & p_matrix,
+                     std::size_t p_first) noexcept
+{
+  return [&p_matrix, p_first](std::size_t p_row) {
+    return &p_matrix.data()[p_row * p_matrix.size2() + p_first];
+  };
+}
+
+template<typename T>
+constexpr auto lanes(const matrix<T> & p_matrix,
+                     std::size_t p_first) noexcept
+{
+  return [&p_matrix, p_first](std::size_t p_row) {
+    return &p_matrix.data()[p_row * p_matrix.size2() + p_first];
+  };
+}
+
+} // namespace matrix_batch_detail
+
+// Factor every n x n matrix of p_a (batch_packed_size(n) x count) in
+// place; p_inv_diag (n x count) receives 1 / L_ii. Returns the number of
+// matrices that weren't positive definite, flagged in p_failed.
+template<typename T>
+std::size_t batch_cholesky_factor(matrix<T> & p_a,
+                                  std::size_t p_n,
+                                  matrix<T> & p_inv_diag,
+                                  batch_mask & p_failed) noexcept
+{
+  const std::size_t count = p_a.size2();
+  p_failed.assign((count + batch_width - 1) / batch_width, 0);
+
+  std::size_t failures = 0;
+  for(std::size_t first = 0; first < count; first += batch_width)
+  {
+    const std::size_t width = std::min(batch_width, count - first);
+    const std::uint64_t failed = matrix_batch_detail::choldc1(matrix_batch_detail::lanes(p_a, first),
+                                                              matrix_batch_detail::lanes(p_inv_diag, first),
+                                                              p_n,
+                                                              width);
+
+    p_failed[first / batch_width] = failed;
+    failures += static_cast<std::size_t>(std::popcount(failed));
+  }
+
+  return failures;
+}
+
+// Solve A x = b for every matrix, from batch_cholesky_factor()'s output.
+// p_b is n x count, one right hand side per column.
+template<typename T>
+void batch_cholesky_solve(const matrix<T> & p_l,
+                          const matrix<T> & p_inv_diag,
+                          std::size_t p_n,
+                          matrix<T> & p_b) noexcept
+{
+  const std::size_t count = p_b.size2();
+  for(std::size_t first = 0; first < count; first += batch_width)
+  {
+    const std::size_t width = std::min(batch_width, count - first);
+    matrix_batch_detail::cholsl(matrix_batch_detail::lanes(p_l, first),
+                                matrix_batch_detail::lanes(p_inv_diag, first),
+                                matrix_batch_detail::lanes(p_b, first),
+                                p_n,
+                                width);
+  }
+}
+
+// p_a = p_A^{-1}, both batch_packed_size(n) x count (p_a may be p_A).
+// p_inv_diag is n x count scratch. Failed matrices are flagged in
+// p_failed & their p_a is meaningless. Returns the number of failures.
+template<typename T>
+std::size_t batch_invert(const matrix<T> & p_A,
+                         matrix<T> & p_a,
+                         std::size_t p_n,
+                         matrix<T> & p_inv_diag,
+                         batch_mask & p_failed) noexcept
+{
+  if(&p_A != &p_a)
+  {
+    boost::numeric::ublas::noalias(p_a) = p_A;
+  }
+
+  const std::size_t failures = batch_cholesky_factor(p_a, p_n, p_inv_diag, p_failed);
+
+  const std::size_t count = p_a.size2();
+  for(std::size_t first = 0; first < count; first += batch_width)
+  {
+    const std::size_t width = std::min(batch_width, count - first);
+    matrix_batch_detail::cholinv(matrix_batch_detail::lanes(p_a, first),
+                                 matrix_batch_detail::lanes(p_inv_diag, first),
+                                 p_n,
+                                 width);
+  }
+
+  return failures;
+}
+
+} // namespace yafiyogi::yy_maths
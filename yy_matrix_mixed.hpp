@@ -0,0 +1,379 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Mixed precision Cholesky solves for large symmetric positive definite
+// systems. A is factored in float, where choldc1()'s vectorised loops
+// process twice as many elements per instruction, then each solve is
+// refined in double against the original A (as LAPACK's dsposv):
+//   x_0 = 0
+//   r_k = b - A x_k                   (double)
+//   x_{k+1} = x_k + (L L^T)^{-1} r_k  (float factor)
+// until |r_k| <= |x_k| |A| eps sqrt(n), column by column. If the float
+// factor fails or isn't finite (A beyond float's range), or refinement
+// doesn't converge or overflows, the solve falls back to a double
+// choldc1() factor, made on first use.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "boost/numeric/ublas/matrix_expression.hpp"
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_util.hpp"
+
+namespace yafiyogi::yy_maths {
+
+enum class mixed_status
+{
+  refined,  // Low precision factor + refinement converged.
+  fallback, // Solved with the full precision factor.
+  failed    // A isn't positive definite.
+};
+
+template<typename T = double,
+         typename Low = float>
+class mixed_cholesky final
+{
+  public:
+    using value_type = T;
+    using low_type = Low;
+    using matrix = yy_maths::matrix<value_type>;
+    using vector = yy_maths::vector<value_type>;
+    using low_matrix = yy_maths::matrix<low_type>;
+    using low_vector = yy_maths::vector<low_type>;
+    using size_type = typename matrix::size_type;
+
+    static constexpr size_type default_max_steps = 10;
+
+    constexpr mixed_cholesky() noexcept = default;
+    constexpr explicit mixed_cholesky(size_type p_max_steps) noexcept:
+      m_max_steps(p_max_steps)
+    {
+    }
+
+    mixed_cholesky(const mixed_cholesky & other) noexcept = default;
+    mixed_cholesky(mixed_cholesky && other) noexcept = default;
+
+    mixed_cholesky & operator=(const mixed_cholesky & other) noexcept = default;
+    mixed_cholesky & operator=(mixed_cholesky && other) noexcept = default;
+
+    // Factor A, which must be stored in full (both triangles) as the
+    // residuals use all of it. A is copied so needn't outlive the
+    // factor. Returns false if A isn't positive definite.
+    template<typename E>
+    bool factor(const boost::numeric::ublas::matrix_expression<E> & p_A) noexcept
+    {
+      const E & A = p_A();
+      const size_type size = A.size1();
+
+      if(A.size2() != size)
+      {
+        return false;
+      }
+
+      m_A.resize(size, size, false);
+      m_low.resize(size, size, false);
+      m_low_p.resize(size, false);
+      m_A_norm = value_type{};
+      m_full_factored = false;
+
+      bool low_range = true;
+      for(size_type i = 0; i < size; ++i)
+      {
+        value_type row_sum{};
+        for(size_type j = 0; j < size; ++j)
+        {
+          const value_type a_ij = A(i, j);
+          const bool in_range = in_low_range(a_ij);
+          m_A(i, j) = a_ij;
+          m_low(i, j) = in_range ? static_cast<low_type>(a_ij) : low_type{};
+          low_range = low_range && in_range;
+          row_sum += std::abs(a_ij);
+        }
+        m_A_norm = std::max(m_A_norm, row_sum);
+      }
+
+      m_low_ok = low_range
+                 && cholesky_factor(m_low, m_low_p)
+                 && low_factor_finite();
+      if(!m_low_ok)
+      {
+        factor_full();
+        return m_full_ok;
+      }
+
+      return true;
+    }
+
+    // Solve A x = b in place.
+    mixed_status solve(vector & p_b) noexcept
+    {
+      m_steps = 0;
+      if(p_b.size() != m_A.size1())
+      {
+        return mixed_status::failed;
+      }
+
+      if(m_low_ok && refine(p_b))
+      {
+        return mixed_status::refined;
+      }
+
+      factor_full();
+      if(!m_full_ok)
+      {
+        return mixed_status::failed;
+      }
+
+      // p_b is untouched until refinement converges.
+      cholesky_solve(m_full, m_full_p, p_b);
+
+      return mixed_status::fallback;
+    }
+
+    // Solve A X = B in place, a column of B at a time. Reports fallback
+    // if any column needed the full precision factor.
+    mixed_status solve(matrix & p_B) noexcept
+    {
+      const size_type size = m_A.size1();
+      const size_type columns = p_B.size2();
+
+      if(p_B.size1() != size)
+      {
+        m_steps = 0;
+        return mixed_status::failed;
+      }
+
+      mixed_status status = mixed_status::refined;
+      size_type steps = 0;
+
+      m_b.resize(size, false);
+      for(size_type c = 0; c < columns; ++c)
+      {
+        for(size_type i = 0; i < size; ++i)
+        {
+          m_b(i) = p_B(i, c);
+        }
+
+        const mixed_status column_status = solve(m_b);
+        if(mixed_status::failed == column_status)
+        {
+          return column_status;
+        }
+
+        if(mixed_status::fallback == column_status)
+        {
+          status = column_status;
+        }
+        steps = std::max(steps, m_steps);
+
+        for(size_type i = 0; i < size; ++i)
+        {
+          p_B(i, c) = m_b(i);
+        }
+      }
+
+      m_steps = steps;
+
+      return status;
+    }
+
+    // Most refinement steps any column of the last solve() took.
+    constexpr size_type steps() const noexcept
+    {
+      return m_steps;
+    }
+
+  private:
+    void factor_full() noexcept
+    {
+      if(!m_full_factored)
+      {
+        m_full.resize(m_A.size1(), m_A.size2(), false);
+        m_full_p.resize(m_A.size1(), false);
+        m_full_ok = cholesky_factor(m_A, m_full, m_full_p);
+        m_full_factored = true;
+      }
+    }
+
+    // Converting a value beyond low_type's range (or NaN) is undefined.
+    static bool in_low_range(value_type p_value) noexcept
+    {
+      return std::abs(p_value) <= static_cast<value_type>(std::numeric_limits<low_type>::max());
+    }
+
+    // An A near the top of low_type's range can still overflow the
+    // factor to inf/NaN without tripping choldc1()'s positive pivot test.
+    bool low_factor_finite() const noexcept
+    {
+      const size_type size = m_low.size1();
+      for(size_type i = 0; i < size; ++i)
+      {
+        if(!std::isfinite(m_low_p(i)))
+        {
+          return false;
+        }
+
+        for(size_type j = 0; j < i; ++j)
+        {
+          if(!std::isfinite(m_low(i, j)))
+          {
+            return false;
+          }
+        }
+      }
+
+      return true;
+    }
+
+    // Infinity norm. Unlike std::max(), keeps a NaN element, so the
+    // caller's isfinite() check sees it.
+    template<typename V>
+    static typename V::value_type inf_norm(const V & p_v) noexcept
+    {
+      using norm_type = typename V::value_type;
+
+      norm_type norm{};
+      const size_type size = p_v.size();
+      for(size_type i = 0; i < size; ++i)
+      {
+        const norm_type abs_v = std::abs(p_v(i));
+        if(!(abs_v <= norm))
+        {
+          norm = abs_v;
+        }
+      }
+
+      return norm;
+    }
+
+    bool converged(value_type p_r_norm,
+                   value_type p_x_norm) const noexcept
+    {
+      using std::sqrt;
+
+      const size_type size = m_A.size1();
+      const value_type tolerance = m_A_norm
+                                   * std::numeric_limits<value_type>::epsilon()
+                                   * sqrt(static_cast<value_type>(size));
+
+      return p_r_norm <= p_x_norm * tolerance;
+    }
+
+    bool refine(vector & p_b) noexcept
+    {
+      const size_type size = m_A.size1();
+
+      m_x.resize(size, false);
+      m_r.resize(size, false);
+      m_r_low.resize(size, false);
+      m_x.clear();
+
+      for(size_type step = 0; step <= m_max_steps; ++step)
+      {
+        // r_k = b - A x_k = b - sum_j x_j A(j, :), as A is symmetric, so
+        // each term is an axpy along a contiguous row of A.
+        boost::numeric::ublas::noalias(m_r) = p_b;
+        if(0 != step)
+        {
+          value_type * r = &m_r(0);
+          for(size_type j = 0; j < size; ++j)
+          {
+            const value_type x_j = m_x(j);
+            const value_type * a_j = &m_A(j, 0);
+            for(size_type i = 0; i < size; ++i)
+            {
+              r[i] -= x_j * a_j[i];
+            }
+          }
+
+          const value_type r_norm = inf_norm(m_r);
+          const value_type x_norm = inf_norm(m_x);
+          if(!std::isfinite(r_norm) || !std::isfinite(x_norm))
+          {
+            m_steps = step;
+            return false; // Overflowed, won't converge.
+          }
+
+          if(converged(r_norm, x_norm))
+          {
+            m_steps = step;
+            p_b.swap(m_x);
+            return true;
+          }
+        }
+
+        // x_{k+1} = x_k + (L L^T)^{-1} r_k
+        for(size_type i = 0; i < size; ++i)
+        {
+          if(!in_low_range(m_r(i)))
+          {
+            m_steps = step;
+            return false; // Residual beyond low_type's range.
+          }
+          m_r_low(i) = static_cast<low_type>(m_r(i));
+        }
+
+        cholesky_solve(m_low, m_low_p, m_r_low);
+        if(!std::isfinite(inf_norm(m_r_low)))
+        {
+          m_steps = step;
+          return false; // Correction overflowed.
+        }
+
+        for(size_type i = 0; i < size; ++i)
+        {
+          m_x(i) += static_cast<value_type>(m_r_low(i));
+        }
+      }
+
+      m_steps = m_max_steps;
+
+      return false;
+    }
+
+    matrix m_A{};            // Original A, for the residuals.
+    value_type m_A_norm{};   // |A|, infinity norm.
+    low_matrix m_low{};      // Low precision factor.
+    low_vector m_low_p{};
+    bool m_low_ok = false;
+    matrix m_full{};         // Full precision factor, made on fallback.
+    vector m_full_p{};
+    bool m_full_factored = false;
+    bool m_full_ok = false;
+    vector m_x{};            // Refined solution.
+    vector m_r{};            // Residual.
+    low_vector m_r_low{};    // Residual & correction in low precision.
+    vector m_b{};            // Column of B being solved.
+    size_type m_max_steps = default_max_steps;
+    size_type m_steps = 0;
+};
+
+} // namespace yafiyogi::yy_maths
@@ -0,0 +1,519 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Multithreaded invert() for large symmetric positive definite matrices.
+// The Cholesky factor is tiled & each tile operation
+//   potrf(k)      factor diagonal tile (k, k)
+//   trsm(i, k)    L(i, k) = A(i, k) L(k, k)^{-T}
+//   update(i,j,k) A(i, j) -= L(i, k) L(j, k)^T
+// is a task, run by a pool of workers as soon as the tiles it reads are
+// final, so work from later panels overlaps the tail of earlier ones.
+// The inverse A^{-1} = L^{-T} L^{-1} is then formed row parallel.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "yy_matrix.hpp"
+#include "yy_matrix_util.hpp"
+
+namespace yafiyogi::yy_maths {
+
+// Below this many rows invert() stays serial.
+inline constexpr std::size_t invert_parallel_min = 512;
+
+namespace matrix_parallel_detail {
+
+inline constexpr std::size_t tile_size = 64;
+
+// Run p_fn(idx) for idx in [0, p_count) on up to p_threads threads,
+// idx interleaved across threads so triangular work stays balanced.
+template<typename Fn>
+void parallel_for(std::size_t p_threads,
+                  std::size_t p_count,
+                  Fn && p_fn) noexcept
+{
+  auto run = [&p_fn, p_threads, p_count](std::size_t p_first) {
+    for(std::size_t idx = p_first; idx < p_count; idx += p_threads)
+    {
+      p_fn(idx);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  std::size_t started = 1; // This thread takes stride 0.
+  try
+  {
+    workers.reserve(p_threads - 1);
+    for(; started < p_threads; ++started)
+    {
+      workers.emplace_back(run, started);
+    }
+  }
+  catch(const std::exception &)
+  {
+  }
+
+  run(0);
+
+  // Strides no thread could be started for.
+  for(std::size_t first = started; first < p_threads; ++first)
+  {
+    run(first);
+  }
+
+  for(auto & worker : workers)
+  {
+    worker.join();
+  }
+}
+
+template<typename T>
+class tiled_cholesky final
+{
+  public:
+    using matrix_type = matrix<T>;
+    using value_type = typename matrix_type::value_type;
+    using size_type = typename matrix_type::size_type;
+
+    // Factors the lower triangle (incl. diagonal) of p_a in place. L^T is
+    // also written above the diagonal, so updates run along rows.
+    tiled_cholesky(matrix_type & p_a) noexcept:
+      m_a(p_a),
+      m_size(p_a.size1()),
+      m_tiles((m_size + tile_size - 1) / tile_size),
+      m_updates(tile_count(), 0),
+      m_trsm_done(tile_count(), 0),
+      m_potrf_done(m_tiles, 0)
+    {
+      // potrf per diagonal, trsm per sub diagonal tile & one update per
+      // tile per earlier panel.
+      for(size_type k = 0; k < m_tiles; ++k)
+      {
+        const size_type below = m_tiles - k - 1;
+        m_remaining += 1 + below + (below * (below + 1)) / 2;
+      }
+    }
+
+    tiled_cholesky(const tiled_cholesky &) = delete;
+    tiled_cholesky & operator=(const tiled_cholesky &) = delete;
+
+    bool run(std::size_t p_threads) noexcept
+    {
+      m_ready.push_back(task{op::potrf, 0, 0, 0});
+
+      std::vector<std::thread> workers;
+      try
+      {
+        workers.reserve(p_threads - 1);
+        for(std::size_t t = 1; t < p_threads; ++t)
+        {
+          workers.emplace_back([this]() { work(); });
+        }
+      }
+      catch(const std::exception &)
+      {
+        // Carry on with the workers that did start.
+      }
+
+      work();
+
+      for(auto & worker : workers)
+      {
+        worker.join();
+      }
+
+      return !m_failed;
+    }
+
+  private:
+    enum class op {potrf, trsm, update};
+
+    struct task final
+    {
+        op kind;
+        size_type i;
+        size_type j;
+        size_type k;
+    };
+
+    size_type tile_count() const noexcept
+    {
+      return (m_tiles * (m_tiles + 1)) / 2;
+    }
+
+    static constexpr size_type idx(size_type i,
+                                   size_type j) noexcept
+    {
+      return ((i * (i + 1)) / 2) + j;
+    }
+
+    size_type first(size_type p_tile) const noexcept
+    {
+      return p_tile * tile_size;
+    }
+
+    size_type last(size_type p_tile) const noexcept
+    {
+      return std::min(first(p_tile + 1), m_size);
+    }
+
+    void work() noexcept
+    {
+      for(;;)
+      {
+        task t{};
+        {
+          std::unique_lock lock{m_mutex};
+          m_cv.wait(lock, [this]() {
+            return !m_ready.empty() || (0 == m_remaining) || m_failed;
+          });
+
+          if(m_failed || (0 == m_remaining))
+          {
+            return;
+          }
+
+          t = m_ready.front();
+          m_ready.pop_front();
+        }
+
+        const bool ok = execute(t);
+
+        {
+          std::lock_guard lock{m_mutex};
+          if(!ok)
+          {
+            m_failed = true;
+          }
+          else
+          {
+            complete(t);
+            --m_remaining;
+          }
+        }
+        m_cv.notify_all();
+      }
+    }
+
+    bool execute(const task & p_task) noexcept
+    {
+      switch(p_task.kind)
+      {
+        case op::potrf:
+          return potrf(p_task.k);
+
+        case op::trsm:
+          trsm(p_task.i, p_task.k);
+          break;
+
+        case op::update:
+          update(p_task.i, p_task.j, p_task.k);
+          break;
+      }
+
+      return true;
+    }
+
+    // Called with m_mutex held: queue the tasks p_task unblocked.
+    void complete(const task & p_task) noexcept
+    {
+      const size_type k = p_task.k;
+
+      switch(p_task.kind)
+      {
+        case op::potrf:
+          m_potrf_done[k] = 1;
+          for(size_type i = k + 1; i < m_tiles; ++i)
+          {
+            if(k == m_updates[idx(i, k)])
+            {
+              m_ready.push_back(task{op::trsm, i, k, k});
+            }
+          }
+          break;
+
+        case op::trsm:
+        {
+          const size_type i = p_task.i;
+          m_trsm_done[idx(i, k)] = 1;
+
+          // Tiles (i, j) of row i need L(i, k) & L(j, k).
+          for(size_type j = k + 1; j <= i; ++j)
+          {
+            if(((j == i) || m_trsm_done[idx(j, k)])
+               && (k == m_updates[idx(i, j)]))
+            {
+              m_ready.push_back(task{op::update, i, j, k});
+            }
+          }
+
+          // Tiles (r, i) of later rows need L(r, k) & L(i, k).
+          for(size_type r = i + 1; r < m_tiles; ++r)
+          {
+            if(m_trsm_done[idx(r, k)]
+               && (k == m_updates[idx(r, i)]))
+            {
+              m_ready.push_back(task{op::update, r, i, k});
+            }
+          }
+          break;
+        }
+
+        case op::update:
+        {
+          const size_type i = p_task.i;
+          const size_type j = p_task.j;
+          const size_type done = ++m_updates[idx(i, j)];
+
+          if(done == j)
+          {
+            // Tile (i, j) is final.
+            if(i == j)
+            {
+              m_ready.push_back(task{op::potrf, j, j, j});
+            }
+            else if(m_potrf_done[j])
+            {
+              m_ready.push_back(task{op::trsm, i, j, j});
+            }
+          }
+          else if(m_trsm_done[idx(i, done)] && m_trsm_done[idx(j, done)])
+          {
+            m_ready.push_back(task{op::update, i, j, done});
+          }
+          break;
+        }
+      }
+    }
+
+    bool potrf(size_type p_k) noexcept
+    {
+      using std::sqrt;
+
+      const size_type begin = first(p_k);
+      const size_type end = last(p_k);
+
+      for(size_type c = begin; c < end; ++c)
+      {
+        const value_type d = m_a(c, c);
+        if(d <= value_type{})
+        {
+          return false;
+        }
+
+        const value_type l_cc = sqrt(d);
+        m_a(c, c) = l_cc;
+
+        for(size_type r = c + 1; r < end; ++r)
+        {
+          m_a(r, c) /= l_cc;
+        }
+
+        for(size_type r = c + 1; r < end; ++r)
+        {
+          value_type * a_r = &m_a(r, 0);
+          const value_type l_rc = a_r[c];
+          for(size_type s = c + 1; s <= r; ++s)
+          {
+            a_r[s] -= l_rc * m_a(s, c);
+          }
+        }
+      }
+
+      return true;
+    }
+
+    void trsm(size_type p_i,
+              size_type p_k) noexcept
+    {
+      const size_type k_begin = first(p_k);
+      const size_type k_end = last(p_k);
+
+      for(size_type r = first(p_i); r < last(p_i); ++r)
+      {
+        value_type * a_r = &m_a(r, 0);
+        for(size_type c = k_begin; c < k_end; ++c)
+        {
+          const value_type * a_c = &m_a(c, 0);
+          value_type sum = a_r[c];
+          for(size_type t = k_begin; t < c; ++t)
+          {
+            sum -= a_r[t] * a_c[t];
+          }
+
+          const value_type l_rc = sum / a_c[c];
+          a_r[c] = l_rc;
+          m_a(c, r) = l_rc; // L^T
+        }
+      }
+    }
+
+    void update(size_type p_i,
+                size_type p_j,
+                size_type p_k) noexcept
+    {
+      const size_type j_begin = first(p_j);
+      const size_type j_end = last(p_j);
+
+      for(size_type r = first(p_i); r < last(p_i); ++r)
+      {
+        value_type * a_r = &m_a(r, 0);
+        const size_type s_end = (p_i == p_j) ? r + 1 : j_end;
+
+        for(size_type t = first(p_k); t < last(p_k); ++t)
+        {
+          const value_type l_rt = a_r[t];
+          const value_type * a_t = &m_a(t, 0); // L^T row t
+          for(size_type s = j_begin; s < s_end; ++s)
+          {
+            a_r[s] -= l_rt * a_t[s];
+          }
+        }
+      }
+    }
+
+    matrix_type & m_a;
+    size_type m_size = 0;
+    size_type m_tiles = 0;
+    std::vector<size_type> m_updates;      // Per lower tile, panels applied.
+    std::vector<unsigned char> m_trsm_done; // Per lower tile.
+    std::vector<unsigned char> m_potrf_done; // Per diagonal tile.
+    std::deque<task> m_ready{};
+    size_type m_remaining = 0;
+    bool m_failed = false;
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+};
+
+} // namespace matrix_parallel_detail
+
+// As invert(), using up to p_threads threads (0 for one per hardware
+// thread) once A has at least invert_parallel_min rows.
+template<typename T>
+bool invert(const matrix<T> & A,
+            matrix<T> & a,
+            vector<T> & p_tmp,
+            std::size_t p_threads) noexcept
+{
+  using matrix_type = matrix<T>;
+  using value_type = typename matrix_type::value_type;
+  using size_type = typename matrix_type::size_type;
+
+  if(0 == p_threads)
+  {
+    p_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  const size_type size = A.size1();
+  if((p_threads <= 1) || (size < invert_parallel_min))
+  {
+    return invert(A, a, p_tmp);
+  }
+
+  if((A.size1() != A.size2())
+     || (A.size1() != a.size2())
+     || (a.size1() != a.size2())
+     || (p_tmp.size() < A.size1()))
+  {
+    return false;
+  }
+
+  // A's upper triangle into the lower triangle of a.
+  for(size_type i = 0; i < size; ++i)
+  {
+    for(size_type j = 0; j <= i; ++j)
+    {
+      a(i, j) = A(j, i);
+    }
+  }
+
+  {
+    matrix_parallel_detail::tiled_cholesky<T> factor{a};
+    if(!factor.run(p_threads))
+    {
+      return false;
+    }
+  }
+
+  vector<T> & p = p_tmp;
+  for(size_type i = 0; i < size; ++i)
+  {
+    p(i) = value_type{1} / a(i, i);
+  }
+
+  // U = L^{-T} above the diagonal, row i of U from column i of L^{-1}:
+  //   U(i, j) = -sum_{k=i}^{j-1} L(j, k) U(i, k) / L(j, j), U(i, i) = 1 / L(i, i)
+  matrix_parallel_detail::parallel_for(p_threads, size, [&a, &p, size](size_type i) {
+    value_type * u_i = &a(i, 0);
+    for(size_type j = i + 1; j < size; ++j)
+    {
+      const value_type * l_j = &a(j, 0);
+      value_type sum = l_j[i] * p(i);
+      for(size_type k = i + 1; k < j; ++k)
+      {
+        sum += l_j[k] * u_i[k];
+      }
+      u_i[j] = -sum * p(j);
+    }
+  });
+
+  // A^{-1}(i, j) = sum_{k>=i} U(i, k) U(j, k), j <= i, into the lower triangle.
+  matrix_parallel_detail::parallel_for(p_threads, size, [&a, &p, size](size_type i) {
+    const value_type * u_i = &a(i, 0);
+    for(size_type j = 0; j <= i; ++j)
+    {
+      const value_type * u_j = &a(j, 0);
+      const value_type u_ji = (j == i) ? p(i) : u_j[i];
+      value_type sum = p(i) * u_ji;
+      for(size_type k = i + 1; k < size; ++k)
+      {
+        sum += u_i[k] * u_j[k];
+      }
+      a(i, j) = sum;
+    }
+  });
+
+  for(size_type i = 0; i < size; ++i)
+  {
+    for(size_type j = i + 1; j < size; ++j)
+    {
+      a(i, j) = a(j, i);
+    }
+  }
+
+  return true;
+}
+
+} // namespace yafiyogi::yy_maths
@@ -26,16 +26,104 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "boost/numeric/ublas/matrix_proxy.hpp"
+
 #include "yy_matrix.hpp"
 
 namespace yafiyogi::yy_maths {
 
-template<typename T>
-matrix<T> & mask_lower_triangle(matrix<T> & m)
+// C = A B, or C += A B when p_init is false. Unlike boost's axpy_prod()
+// no temporaries are created, so C must already be sized and must not
+// alias A or B.
+template<typename E1,
+         typename E2,
+         typename M>
+constexpr M & multiply(const boost::numeric::ublas::matrix_expression<E1> & p_a,
+                       const boost::numeric::ublas::matrix_expression<E2> & p_b,
+                       M & p_c,
+                       bool p_init = true) noexcept
+{
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
+
+  const E1 & A = p_a();
+  const E2 & B = p_b();
+  const size_type rows = A.size1();
+  const size_type inner = A.size2();
+  const size_type columns = B.size2();
+
+  for(size_type i = 0; i < rows; ++i)
+  {
+    if(p_init)
+    {
+      for(size_type j = 0; j < columns; ++j)
+      {
+        p_c(i, j) = value_type{};
+      }
+    }
+
+    for(size_type k = 0; k < inner; ++k)
+    {
+      const value_type a_ik = A(i, k);
+
+      for(size_type j = 0; j < columns; ++j)
+      {
+        p_c(i, j) += a_ik * B(k, j);
+      }
+    }
+  }
+
+  return p_c;
+}
+
+// y = A x, or y += A x when p_init is false.
+template<typename E1,
+         typename E2,
+         typename V>
+constexpr V & multiply(const boost::numeric::ublas::matrix_expression<E1> & p_a,
+                       const boost::numeric::ublas::vector_expression<E2> & p_x,
+                       V & p_y,
+                       bool p_init = true) noexcept
 {
-  using matrix_type = matrix<T>;
-  using value_type = typename matrix_type::value_type;
-  using size_type = typename matrix_type::size_type;
+  using value_type = typename V::value_type;
+  using size_type = typename V::size_type;
+
+  const E1 & A = p_a();
+  const E2 & x = p_x();
+  const size_type rows = A.size1();
+  const size_type columns = A.size2();
+
+  for(size_type i = 0; i < rows; ++i)
+  {
+    value_type sum{};
+    for(size_type j = 0; j < columns; ++j)
+    {
+      sum += A(i, j) * x(j);
+    }
+
+    if(p_init)
+    {
+      p_y(i) = sum;
+    }
+    else
+    {
+      p_y(i) += sum;
+    }
+  }
+
+  return p_y;
+}
+
+template<typename M>
+constexpr M & mask_lower_triangle(M & m) noexcept
+{
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
 
   const size_type size = m.size1();
   for(size_type i = 0; i < size; ++i)
@@ -49,11 +137,10 @@ matrix<T> & mask_lower_triangle(matrix<T> & m)
   return m;
 }
 
-template<typename T>
-matrix<T> & mirror_lower_triangle(matrix<T> & m)
+template<typename M>
+constexpr M & mirror_lower_triangle(M & m) noexcept
 {
-  using matrix_type = matrix<T>;
-  using size_type = typename matrix_type::size_type;
+  using size_type = typename M::size_type;
 
   const size_type size = m.size1();
   for(size_type i = 0; i < size; ++i)
@@ -68,28 +155,125 @@ matrix<T> & mirror_lower_triangle(matrix<T> & m)
 }
 
 namespace matrix_util_detail {
+
+// Row major storage whose rows are contiguous, so the kernels below can
+// walk a row through a pointer. Anything else (column major, slices,
+// symmetric adaptors...) goes through operator().
+template<typename M>
+struct dense_rows:
+  std::false_type
+{
+};
+
+template<typename T,
+         typename A>
+struct dense_rows<boost::numeric::ublas::matrix<T, boost::numeric::ublas::row_major, A>>:
+  std::true_type
+{
+};
+
+template<typename T,
+         std::size_t N,
+         std::size_t M>
+struct dense_rows<boost::numeric::ublas::c_matrix<T, N, M>>:
+  std::true_type
+{
+};
+
+template<typename T,
+         std::size_t N,
+         std::size_t M>
+struct dense_rows<boost::numeric::ublas::bounded_matrix<T, N, M, boost::numeric::ublas::row_major>>:
+  std::true_type
+{
+};
+
+template<typename M>
+struct dense_rows<boost::numeric::ublas::matrix_range<M>>:
+  dense_rows<std::remove_const_t<M>>
+{
+};
+
+template<typename M>
+inline constexpr bool dense_rows_v = dense_rows<std::remove_cvref_t<M>>::value;
+
+template<typename M>
+class row_ref final
+{
+  public:
+    using size_type = typename M::size_type;
+
+    constexpr row_ref(M & p_m,
+                      size_type p_row) noexcept:
+      m_m(p_m),
+      m_row(p_row)
+    {
+    }
+
+    constexpr decltype(auto) operator[](size_type p_column) const noexcept
+    {
+      return m_m(m_row, p_column);
+    }
+
+  private:
+    M & m_m;
+    size_type m_row;
+};
+
+// Row p_row of p_m, indexed by column.
+template<typename M>
+constexpr auto row_of(M & p_m,
+                      typename M::size_type p_row) noexcept
+{
+  if constexpr(dense_rows_v<M>)
+  {
+    return &p_m(p_row, 0);
+  }
+  else
+  {
+    return row_ref<M>{p_m, p_row};
+  }
+}
+
 // From https://web.archive.org/web/20231002021242/http://jean-pierre.moreau.pagesperso-orange.fr:80/Cplus/choles_cpp.txt
 // and https://github.com/simondlevy/TinyEKF/blob/master/src/tinyekf.h
 
-template<typename T>
-constexpr bool choldc1(matrix<T> & a,
-                       vector<T> & p) noexcept
+// Factor the leading p_size x p_size block of a, read from its upper
+// triangle. L is left strictly below the diagonal & the diagonal of L in
+// p; a's diagonal is untouched & its upper triangle is scratch.
+//
+// Small blocks use the textbook left looking loop (dot products along
+// rows). Larger ones are blocked right looking: factor a panel of
+// cholesky_block columns, then subtract its contribution from the
+// trailing matrix, A22 -= L21 L21^T. L^T is kept in the upper triangle
+// so every inner loop is an axpy along a row, which vectorises, and each
+// trailing row stays in cache while the whole panel is applied to it.
+inline constexpr std::size_t cholesky_block = 32;
+inline constexpr std::size_t cholesky_blocked_min = 256;
+
+template<typename M,
+         typename V>
+constexpr bool choldc1_unblocked(M & a,
+                                 V & p,
+                                 typename M::size_type p_size) noexcept
 {
-  using matrix_type = matrix<T>;
-  using value_type = typename matrix_type::value_type;
-  using size_type = typename matrix_type::size_type;
+  using std::sqrt;
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
 
-  const size_type size = a.size1();
+  const size_type size = p_size;
 
   for(size_type i = 0; i < size; ++i)
   {
+    const auto a_i = row_of(a, i);
     for(size_type j = i; j < size; ++j)
     {
-      value_type sum = a(i, j);
+      const auto a_j = row_of(a, j);
+      value_type sum = a_i[j];
 
-      for(int k = static_cast<int>(i) - 1; k >= 0; --k)
+      for(size_type k = 0; k < i; ++k)
       {
-        sum -= a(i, static_cast<size_type>(k)) * a(j, static_cast<size_type>(k));
+        sum -= a_i[k] * a_j[k];
       }
 
       if(i == j)
@@ -110,26 +294,206 @@ constexpr bool choldc1(matrix<T> & a,
   return true; // success
 }
 
-template<typename T>
-constexpr bool choldcsl(const matrix<T> & A,
-                        matrix<T> & a,
-                        vector<T> & p) noexcept
+template<typename M,
+         typename V>
+constexpr bool choldc1(M & a,
+                       V & p,
+                       typename M::size_type p_size) noexcept
 {
-  using matrix_type = matrix<T>;
-  using value_type = typename matrix_type::value_type;
-  using size_type = typename matrix_type::size_type;
+  using std::sqrt;
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
 
-  a = A;
+  const size_type size = p_size;
 
-  if(!choldc1(a, p))
+  if(size < cholesky_blocked_min)
   {
-    return false;
+    return choldc1_unblocked(a, p, size);
   }
 
-  const size_type size = A.size1();
+  // Work on A in the lower triangle & p.
   for(size_type i = 0; i < size; ++i)
   {
-    a(i, i) = 1 / p[i];
+    p(i) = a(i, i);
+    for(size_type j = 0; j < i; ++j)
+    {
+      a(i, j) = a(j, i);
+    }
+  }
+
+  for(size_type kb = 0; kb < size; kb += cholesky_block)
+  {
+    const size_type ke = std::min(kb + size_type{cholesky_block}, size);
+
+    // Panel: columns kb..ke-1, right looking within the panel.
+    for(size_type k = kb; k < ke; ++k)
+    {
+      if(p(k) <= value_type{})
+      {
+        return false; /* error */
+      }
+
+      const value_type l_kk = sqrt(p(k));
+      p(k) = l_kk;
+
+      const auto a_k = row_of(a, k); // Row k, L^T to the right of (k, k).
+      for(size_type i = k + 1; i < size; ++i)
+      {
+        const value_type l_ik = a(i, k) / l_kk;
+        a(i, k) = l_ik;
+        a_k[i] = l_ik;
+      }
+
+      for(size_type i = k + 1; i < size; ++i)
+      {
+        const auto a_i = row_of(a, i);
+        const value_type l_ik = a_i[k];
+        const size_type last = std::min(i, ke);
+        for(size_type j = k + 1; j < last; ++j)
+        {
+          a_i[j] -= l_ik * a_k[j];
+        }
+
+        if(i < ke)
+        {
+          p(i) -= l_ik * l_ik;
+        }
+      }
+    }
+
+    // Trailing matrix: A22 -= L21 L21^T, lower triangle. Four panel
+    // columns per pass, so row i is loaded & stored a quarter as often.
+    for(size_type i = ke; i < size; ++i)
+    {
+      const auto a_i = row_of(a, i);
+      value_type p_i = p(i);
+      size_type t = kb;
+      for(; t + 4 <= ke; t += 4)
+      {
+        const value_type l_0 = a_i[t];
+        const value_type l_1 = a_i[t + 1];
+        const value_type l_2 = a_i[t + 2];
+        const value_type l_3 = a_i[t + 3];
+        const auto a_0 = row_of(a, t);
+        const auto a_1 = row_of(a, t + 1);
+        const auto a_2 = row_of(a, t + 2);
+        const auto a_3 = row_of(a, t + 3);
+        for(size_type j = ke; j < i; ++j)
+        {
+          a_i[j] -= (l_0 * a_0[j] + l_1 * a_1[j]) + (l_2 * a_2[j] + l_3 * a_3[j]);
+        }
+        p_i -= (l_0 * l_0 + l_1 * l_1) + (l_2 * l_2 + l_3 * l_3);
+      }
+
+      for(; t < ke; ++t)
+      {
+        const value_type l_it = a_i[t];
+        const auto a_t = row_of(a, t);
+        for(size_type j = ke; j < i; ++j)
+        {
+          a_i[j] -= l_it * a_t[j];
+        }
+        p_i -= l_it * l_it;
+      }
+      p(i) = p_i;
+    }
+  }
+
+  return true; // success
+}
+
+template<typename M,
+         typename V>
+constexpr bool choldc1(M & a,
+                       V & p) noexcept
+{
+  return choldc1(a, p, a.size1());
+}
+
+// Solve L y = b in place for the leading p_size elements of b, L as
+// left by choldc1().
+template<typename M,
+         typename V,
+         typename B>
+constexpr void cholfs(const M & a,
+                      const V & p,
+                      B & b,
+                      typename M::size_type p_size) noexcept
+{
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
+
+  const size_type size = p_size;
+  for(size_type i = 0; i < size; ++i)
+  {
+    value_type sum = b(i);
+    for(size_type k = 0; k < i; ++k)
+    {
+      sum -= a(i, k) * b(k);
+    }
+    b(i) = sum / p(i);
+  }
+}
+
+template<typename M,
+         typename V,
+         typename B>
+constexpr void cholfs(const M & a,
+                      const V & p,
+                      B & b) noexcept
+{
+  cholfs(a, p, b, a.size1());
+}
+
+// Solve L Y = B in place for the leading p_size rows of B, every
+// column at once so the inner loops run along B's rows.
+template<typename M,
+         typename V,
+         typename B>
+constexpr void cholfs_rows(const M & a,
+                           const V & p,
+                           B & b,
+                           typename M::size_type p_size) noexcept
+{
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
+
+  const size_type size = p_size;
+  const size_type columns = b.size2();
+  for(size_type i = 0; i < size; ++i)
+  {
+    const auto b_i = row_of(b, i);
+    for(size_type k = 0; k < i; ++k)
+    {
+      const value_type l_ik = a(i, k);
+      const auto b_k = row_of(b, k);
+      for(size_type c = 0; c < columns; ++c)
+      {
+        b_i[c] -= l_ik * b_k[c];
+      }
+    }
+
+    const value_type inv_l_ii = value_type{1} / p(i);
+    for(size_type c = 0; c < columns; ++c)
+    {
+      b_i[c] *= inv_l_ii;
+    }
+  }
+}
+
+// L^{-1} in the lower triangle of a, from the factor left by choldc1().
+template<typename M,
+         typename V>
+constexpr void choldcsl_factored(M & a,
+                                 const V & p) noexcept
+{
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
+
+  const size_type size = a.size1();
+  for(size_type i = 0; i < size; ++i)
+  {
+    a(i, i) = value_type{1} / p(i);
     for(size_type j = i + 1; j < size; ++j)
     {
       value_type sum{};
@@ -137,27 +501,37 @@ constexpr bool choldcsl(const matrix<T> & A,
       {
         sum -= a(j, k) * a(k, i);
       }
-      a(j, i) = sum / p[j];
+      a(j, i) = sum / p(j);
     }
   }
-
-  return true;
 }
 
-template<typename T>
-constexpr bool cholsl(const matrix<T> & A,
-                      matrix<T> & a,
-                      vector<T> & p) noexcept
+// In place: a holds A on entry.
+template<typename M,
+         typename V>
+constexpr bool choldcsl(M & a,
+                        V & p) noexcept
 {
-  using matrix_type = matrix<T>;
-  using value_type = typename matrix_type::value_type;
-  using size_type = typename matrix_type::size_type;
-
-  if(!choldcsl(A, a, p))
+  if(!choldc1(a, p))
   {
     return false;
   }
 
+  choldcsl_factored(a, p);
+
+  return true;
+}
+
+// A^{-1} in a, from the factor left by choldc1().
+template<typename M,
+         typename V>
+constexpr void cholsl_factored(M & a,
+                               const V & p) noexcept
+{
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
+
+  choldcsl_factored(a, p);
   mask_lower_triangle(a);
 
   const size_type size = a.size1();
@@ -185,26 +559,444 @@ constexpr bool cholsl(const matrix<T> & A,
   }
 
   mirror_lower_triangle(a);
+}
+
+// In place: a holds A on entry.
+template<typename M,
+         typename V>
+constexpr bool cholsl(M & a,
+                      V & p) noexcept
+{
+  if(!choldc1(a, p))
+  {
+    return false;
+  }
+
+  cholsl_factored(a, p);
 
   return true; // success
 }
 
 } // namespace matrix_util_detail
 
-template<typename T>
-constexpr bool invert(const matrix<T> & A,
-                      matrix<T> & a) noexcept
+// Factor symmetric positive definite A = L L^T into a & p: L is left
+// below the diagonal of a & its diagonal in p (the upper triangle of a
+// is scratch). Only A's upper triangle is read, and a may be A itself.
+// A & a may be any ublas matrix or view (e.g. a matrix_range of a larger
+// matrix), p any vector. Returns false if A isn't positive definite.
+template<typename E,
+         typename M,
+         typename V>
+constexpr bool cholesky_factor(const boost::numeric::ublas::matrix_expression<E> & p_A,
+                               M & a,
+                               V & p) noexcept
 {
+  const E & A = p_A();
+
+  if((A.size1() != A.size2())
+     || (a.size1() != A.size1())
+     || (a.size2() != A.size2())
+     || (p.size() < A.size1()))
+  {
+    return false;
+  }
+
+  if(static_cast<const void *>(&A) != static_cast<const void *>(&a))
+  {
+    boost::numeric::ublas::noalias(a) = A;
+  }
+
+  return matrix_util_detail::choldc1(a, p);
+}
+
+// In place: a holds A on entry.
+template<typename M,
+         typename V>
+constexpr bool cholesky_factor(M & a,
+                               V & p) noexcept
+{
+  if((a.size1() != a.size2())
+     || (p.size() < a.size1()))
+  {
+    return false;
+  }
+
+  return matrix_util_detail::choldc1(a, p);
+}
+
+// Solve A x = b in place, from cholesky_factor()'s a & p.
+template<typename E1,
+         typename E2,
+         typename B>
+constexpr void cholesky_solve(const boost::numeric::ublas::matrix_expression<E1> & p_a,
+                              const boost::numeric::ublas::vector_expression<E2> & p_p,
+                              boost::numeric::ublas::vector_expression<B> & p_b) noexcept
+{
+  using value_type = typename B::value_type;
+  using size_type = typename B::size_type;
+
+  const E1 & a = p_a();
+  const E2 & p = p_p();
+  B & b = p_b();
+
+  // L y = b
+  matrix_util_detail::cholfs(a, p, b);
+
+  // L^T x = y, a row of L at a time: once x_i is known, subtract its
+  // contribution from every earlier equation.
+  const size_type size = a.size1();
+  for(size_type i = size; i-- > 0;)
+  {
+    const value_type x_i = b(i) / p(i);
+    b(i) = x_i;
+
+    const auto a_i = matrix_util_detail::row_of(a, i);
+    for(size_type k = 0; k < i; ++k)
+    {
+      b(k) -= a_i[k] * x_i;
+    }
+  }
+}
+
+// Solve A X = B in place for every column of B (a.size1() rows).
+// Works row wise so the inner loops run along B's rows.
+template<typename E1,
+         typename E2,
+         typename M>
+constexpr void cholesky_solve(const boost::numeric::ublas::matrix_expression<E1> & p_a,
+                              const boost::numeric::ublas::vector_expression<E2> & p_p,
+                              boost::numeric::ublas::matrix_expression<M> & p_B) noexcept
+{
+  using value_type = typename M::value_type;
+  using size_type = typename M::size_type;
+
+  const E1 & a = p_a();
+  const E2 & p = p_p();
+  M & B = p_B();
+
+  const size_type size = a.size1();
+  const size_type columns = B.size2();
+
+  // L Y = B
+  matrix_util_detail::cholfs_rows(a, p, B, size);
+
+  // L^T X = Y, a row of L at a time.
+  for(size_type i = size; i-- > 0;)
+  {
+    const auto B_i = matrix_util_detail::row_of(B, i);
+    const value_type inv_l_ii = value_type{1} / p(i);
+    for(size_type c = 0; c < columns; ++c)
+    {
+      B_i[c] *= inv_l_ii;
+    }
+
+    const auto a_i = matrix_util_detail::row_of(a, i);
+    for(size_type k = 0; k < i; ++k)
+    {
+      const value_type l_ik = a_i[k];
+      const auto B_k = matrix_util_detail::row_of(B, k);
+      for(size_type c = 0; c < columns; ++c)
+      {
+        B_k[c] -= l_ik * B_i[c];
+      }
+    }
+  }
+}
+
+namespace matrix_util_detail {
+
+// Largest size invert() handles with invert_fixed().
+inline constexpr std::size_t invert_fixed_max = 4;
+
+// Invert N x N symmetric positive definite A (upper triangle read) into
+// a, which may be A. Closed form (adjugate) for N <= 3, otherwise a
+// Cholesky with compile time trip counts the compiler can fully unroll.
+// Positive definiteness is checked as for choldc1() (Sylvester's
+// criterion for the closed forms).
+template<std::size_t N,
+         typename M1,
+         typename M2>
+constexpr bool invert_fixed(const M1 & A,
+                            M2 & a) noexcept
+{
+  using std::sqrt;
+  using value_type = typename M2::value_type;
+
+  if constexpr(1 == N)
+  {
+    const value_type a00 = A(0, 0);
+    if(a00 <= value_type{})
+    {
+      return false;
+    }
+
+    a(0, 0) = value_type{1} / a00;
+  }
+  else if constexpr(2 == N)
+  {
+    const value_type a00 = A(0, 0);
+    const value_type a01 = A(0, 1);
+    const value_type a11 = A(1, 1);
+    const value_type det = a00 * a11 - a01 * a01;
+
+    if((a00 <= value_type{}) || (det <= value_type{}))
+    {
+      return false;
+    }
+
+    const value_type inv_det = value_type{1} / det;
+    a(0, 0) = a11 * inv_det;
+    a(0, 1) = -a01 * inv_det;
+    a(1, 0) = a(0, 1);
+    a(1, 1) = a00 * inv_det;
+  }
+  else if constexpr(3 == N)
+  {
+    const value_type a00 = A(0, 0);
+    const value_type a01 = A(0, 1);
+    const value_type a02 = A(0, 2);
+    const value_type a11 = A(1, 1);
+    const value_type a12 = A(1, 2);
+    const value_type a22 = A(2, 2);
+
+    // Cofactors.
+    const value_type c00 = a11 * a22 - a12 * a12;
+    const value_type c01 = a02 * a12 - a01 * a22;
+    const value_type c02 = a01 * a12 - a02 * a11;
+    const value_type c11 = a00 * a22 - a02 * a02;
+    const value_type c12 = a01 * a02 - a00 * a12;
+    const value_type c22 = a00 * a11 - a01 * a01;
+    const value_type det = a00 * c00 + a01 * c01 + a02 * c02;
+
+    if((a00 <= value_type{}) || (c22 <= value_type{}) || (det <= value_type{}))
+    {
+      return false;
+    }
+
+    const value_type inv_det = value_type{1} / det;
+    a(0, 0) = c00 * inv_det;
+    a(0, 1) = c01 * inv_det;
+    a(0, 2) = c02 * inv_det;
+    a(1, 0) = a(0, 1);
+    a(1, 1) = c11 * inv_det;
+    a(1, 2) = c12 * inv_det;
+    a(2, 0) = a(0, 2);
+    a(2, 1) = a(1, 2);
+    a(2, 2) = c22 * inv_det;
+  }
+  else
+  {
+    // A = L L^T
+    value_type L[N][N]{};
+    value_type inv_d[N]{};
+    for(std::size_t j = 0; j < N; ++j)
+    {
+      value_type sum = A(j, j);
+      for(std::size_t k = 0; k < j; ++k)
+      {
+        sum -= L[j][k] * L[j][k];
+      }
+
+      if(sum <= value_type{})
+      {
+        return false;
+      }
+
+      inv_d[j] = value_type{1} / sqrt(sum);
+
+      for(std::size_t i = j + 1; i < N; ++i)
+      {
+        value_type l_ij = A(j, i);
+        for(std::size_t k = 0; k < j; ++k)
+        {
+          l_ij -= L[i][k] * L[j][k];
+        }
+        L[i][j] = l_ij * inv_d[j];
+      }
+    }
+
+    // W = L^{-1}
+    value_type W[N][N]{};
+    for(std::size_t i = 0; i < N; ++i)
+    {
+      W[i][i] = inv_d[i];
+      for(std::size_t j = i + 1; j < N; ++j)
+      {
+        value_type sum{};
+        for(std::size_t k = i; k < j; ++k)
+        {
+          sum -= L[j][k] * W[k][i];
+        }
+        W[j][i] = sum * inv_d[j];
+      }
+    }
+
+    // A^{-1} = W^T W
+    for(std::size_t i = 0; i < N; ++i)
+    {
+      for(std::size_t j = i; j < N; ++j)
+      {
+        value_type sum{};
+        for(std::size_t k = j; k < N; ++k)
+        {
+          sum += W[k][i] * W[k][j];
+        }
+        a(i, j) = sum;
+        a(j, i) = sum;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Runtime size to invert_fixed<N>().
+template<typename M1,
+         typename M2>
+constexpr bool invert_small(const M1 & A,
+                            M2 & a) noexcept
+{
+  switch(A.size1())
+  {
+    case 1:
+      return invert_fixed<1>(A, a);
+
+    case 2:
+      return invert_fixed<2>(A, a);
+
+    case 3:
+      return invert_fixed<3>(A, a);
+
+    case 4:
+      return invert_fixed<4>(A, a);
+
+    default:
+      break;
+  }
+
+  return false;
+}
+
+} // namespace matrix_util_detail
+
+// p_tmp is caller supplied scratch of at least A.size1() elements, so
+// repeated inversions needn't allocate. Sizes up to 4 skip the general
+// Cholesky chain for unrolled fixed size inverses. A & a may be any ublas
+// matrix or view, and a may be A itself.
+template<typename E,
+         typename M,
+         typename V>
+constexpr bool invert(const boost::numeric::ublas::matrix_expression<E> & p_A,
+                      M & a,
+                      V & p_tmp) noexcept
+{
+  const E & A = p_A();
+
   if((A.size1() != A.size2())
      || (A.size1() != a.size2())
-     || (a.size1() != a.size2()))
+     || (a.size1() != a.size2())
+     || (p_tmp.size() < A.size1()))
+  {
+    return false;
+  }
+
+  if(A.size1() <= matrix_util_detail::invert_fixed_max)
+  {
+    return matrix_util_detail::invert_small(A, a);
+  }
+
+  if(static_cast<const void *>(&A) != static_cast<const void *>(&a))
+  {
+    boost::numeric::ublas::noalias(a) = A;
+  }
+
+  return matrix_util_detail::cholsl(a, p_tmp);
+}
+
+template<typename E,
+         typename M>
+constexpr bool invert(const boost::numeric::ublas::matrix_expression<E> & p_A,
+                      M & a) noexcept
+{
+  using value_type = typename M::value_type;
+
+  const E & A = p_A();
+
+  if((A.size1() <= matrix_util_detail::invert_fixed_max)
+     && (A.size1() == A.size2())
+     && (a.size1() == A.size1())
+     && (a.size2() == A.size2()))
+  {
+    return matrix_util_detail::invert_small(A, a);
+  }
+
+  vector<value_type> tmp{A.size1()};
+
+  return invert(A, a, tmp);
+}
+
+// In place: a holds A on entry & A^{-1} on success.
+template<typename M,
+         typename V>
+constexpr bool invert_in_place(M & a,
+                               V & p_tmp) noexcept
+{
+  if((a.size1() != a.size2())
+     || (p_tmp.size() < a.size1()))
   {
     return false;
   }
 
-  vector<T> tmp{A.size1()};
+  if(a.size1() <= matrix_util_detail::invert_fixed_max)
+  {
+    return matrix_util_detail::invert_small(a, a);
+  }
+
+  return matrix_util_detail::cholsl(a, p_tmp);
+}
+
+template<typename M>
+constexpr bool invert_in_place(M & a) noexcept
+{
+  using value_type = typename M::value_type;
+
+  if((a.size1() <= matrix_util_detail::invert_fixed_max)
+     && (a.size1() == a.size2()))
+  {
+    return matrix_util_detail::invert_small(a, a);
+  }
+
+  vector<value_type> tmp{a.size1()};
+
+  return invert_in_place(a, tmp);
+}
+
+// Compile time sized: the fixed size path when N <= invert_fixed_max
+// and A fills its N x N storage, no scratch needed. Larger N, or a
+// c_matrix resized below N, goes by its runtime size, with scratch on
+// the stack.
+template<typename T,
+         std::size_t N>
+constexpr bool invert(const c_matrix<T, N, N> & A,
+                      c_matrix<T, N, N> & a) noexcept
+{
+  static_assert(N > 0, "invert() needs a non-empty matrix");
+
+  if constexpr(N <= matrix_util_detail::invert_fixed_max)
+  {
+    if((A.size1() == N)
+       && (A.size2() == N)
+       && (a.size1() == N)
+       && (a.size2() == N))
+    {
+      return matrix_util_detail::invert_fixed<N>(A, a);
+    }
+  }
+
+  const boost::numeric::ublas::matrix_expression<c_matrix<T, N, N>> & A_expr = A;
+  c_vector<T, N> tmp{A.size1()};
 
-  return matrix_util_detail::cholsl(A, a, tmp);
+  return invert(A_expr, a, tmp);
 }
 
 } // namespace yafiyogi::yy_maths
@@ -0,0 +1,134 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Sparse observation matrix H in compressed row form. Each row is a list of
+// (state index, weight) pairs, so a 0/1 selection H is just a gather of
+// state indices. Lets ekf::update() do H P as a row gather & H P H^T as a
+// column gather in O(nnz) rather than dense O(m n^2) products.
+
+#pragma once
+
+#include <vector>
+
+#include "yy_matrix.hpp"
+
+namespace yafiyogi::yy_maths {
+
+template<typename T>
+class sparse_observation final
+{
+  public:
+    using value_type = T;
+    using matrix = yy_maths::matrix<value_type>;
+    using size_type = typename matrix::size_type;
+
+    struct entry final
+    {
+        size_type column = 0;
+        value_type weight{1};
+    };
+
+    using entries_type = std::vector<entry>;
+    using const_iterator = typename entries_type::const_iterator;
+
+    constexpr sparse_observation() noexcept = default;
+    constexpr explicit sparse_observation(size_type p_n) noexcept:
+      m_n(p_n)
+    {
+    }
+
+    // Keep the non-zero elements of a dense H.
+    explicit sparse_observation(const matrix & p_h):
+      m_n(p_h.size2())
+    {
+      const size_type rows = p_h.size1();
+      for(size_type i = 0; i < rows; ++i)
+      {
+        add_row();
+        for(size_type j = 0; j < m_n; ++j)
+        {
+          const value_type weight = p_h(i, j);
+          if(weight != value_type{})
+          {
+            add(j, weight);
+          }
+        }
+      }
+    }
+
+    sparse_observation(const sparse_observation & other) = default;
+    constexpr sparse_observation(sparse_observation && other) noexcept = default;
+
+    sparse_observation & operator=(const sparse_observation & other) = default;
+    constexpr sparse_observation & operator=(sparse_observation && other) noexcept = default;
+
+    // Start a new (empty) measurement row.
+    void add_row()
+    {
+      m_rows.emplace_back(m_entries.size());
+    }
+
+    // Add a state index to the last row.
+    void add(size_type p_column,
+             value_type p_weight = value_type{1})
+    {
+      m_entries.emplace_back(entry{p_column, p_weight});
+    }
+
+    constexpr size_type size1() const noexcept
+    {
+      return m_rows.size();
+    }
+
+    constexpr size_type size2() const noexcept
+    {
+      return m_n;
+    }
+
+    constexpr size_type nnz() const noexcept
+    {
+      return m_entries.size();
+    }
+
+    const_iterator begin(size_type p_row) const noexcept
+    {
+      return m_entries.begin() + static_cast<typename entries_type::difference_type>(m_rows[p_row]);
+    }
+
+    const_iterator end(size_type p_row) const noexcept
+    {
+      const size_type last = ((p_row + 1) < m_rows.size()) ? m_rows[p_row + 1] : m_entries.size();
+
+      return m_entries.begin() + static_cast<typename entries_type::difference_type>(last);
+    }
+
+  private:
+    size_type m_n = 0;
+    std::vector<size_type> m_rows{}; // Start of each row in m_entries.
+    entries_type m_entries{};
+};
+
+} // namespace yafiyogi::yy_maths